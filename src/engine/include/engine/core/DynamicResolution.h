@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Tuning for the dynamic resolution controller.
+ * Scale is applied to both axes (0.5 = quarter of the pixels).
+ */
+struct DynamicResolutionSettings {
+    float minScale = 0.5f;                  // Lowest internal resolution scale
+    float maxScale = 1.0f;                  // Highest internal resolution scale
+    float targetFrameMs = 1000.0f / 60.0f;  // Frame time budget
+    float downscaleThreshold = 0.95f;       // Scale down above this fraction of the budget
+    float upscaleThreshold = 0.70f;         // Scale up below this fraction of the budget
+    float scaleStep = 0.05f;                // Minimum change per decision
+    int sampleWindow = 20;                  // Frames averaged per decision
+    int cooldownFrames = 30;                // Frames to hold after a change (hysteresis)
+};
+
+/**
+ * A single scale change, kept for the stats/debug overlay.
+ */
+struct ResolutionDecision {
+    uint64_t frame;      // Frame index when the change happened
+    float fromScale;
+    float toScale;
+    float cpuTimeMs;     // Averaged CPU frame time that triggered the change
+    float gpuTimeMs;     // Averaged GPU frame time (0 if unavailable)
+};
+
+/**
+ * Picks an internal render scale from recent CPU and GPU frame times.
+ * Scales down when over budget and back up when there is headroom,
+ * with a dead band between thresholds and a cooldown to avoid oscillation.
+ * Does not touch GL - the Engine applies the scale to its render target.
+ */
+class DynamicResolution {
+public:
+    static constexpr size_t MAX_LOG_ENTRIES = 32;
+
+    explicit DynamicResolution(const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+
+    // Replace settings (current scale is clamped to the new bounds)
+    void SetSettings(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& GetSettings() const { return m_settings; }
+
+    // Feed one frame of timings (gpuTimeMs <= 0 means unknown)
+    // Returns true if the scale changed
+    bool AddFrameSample(float cpuTimeMs, float gpuTimeMs);
+
+    // Current scale in [minScale, maxScale]
+    float GetScale() const { return m_scale; }
+
+    // Most recent scale changes, oldest first
+    const std::deque<ResolutionDecision>& GetDecisionLog() const { return m_log; }
+
+    // Return to max scale and forget history
+    void Reset();
+
+private:
+    DynamicResolutionSettings m_settings;
+    float m_scale = 1.0f;
+
+    // Ring buffers of recent timings
+    std::vector<float> m_cpuSamples;
+    std::vector<float> m_gpuSamples;
+    size_t m_sampleIndex = 0;
+    size_t m_sampleCount = 0;
+
+    int m_cooldown = 0;
+    uint64_t m_frame = 0;
+    std::deque<ResolutionDecision> m_log;
+
+    void ClearSamples();
+    void ChangeScale(float newScale, float cpuAvg, float gpuAvg);
+};
+
+} // namespace engine
@@ -3,7 +3,13 @@
 #include "engine/platform/Window.h"
 #include "engine/platform/Input.h"
 #include "engine/gfx/GLContext.h"
+#include "engine/gfx/GpuTimer.h"
+#include "engine/gfx/GLUploadThread.h"
+#include "engine/gfx/RenderTarget.h"
+#include "engine/core/DynamicResolution.h"
+#include "engine/core/FrameStats.h"
 #include <functional>
+#include <memory>
 
 namespace engine {
 
@@ -46,17 +52,45 @@ public:
     void SetResizeCallback(ResizeCallback callback) {
         m_resizeCallback = std::move(callback);
     }
+    
+    // Dynamic resolution: render into a scaled offscreen target and upscale to the window.
+    // The scale follows recent frame times within the configured bounds.
+    void EnableDynamicResolution(const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+    void DisableDynamicResolution();
+    bool IsDynamicResolutionEnabled() const { return m_dynamicResolution != nullptr; }
+    
+    // Controller state (current scale, decision log), nullptr when disabled
+    const DynamicResolution* GetDynamicResolution() const { return m_dynamicResolution.get(); }
+    
+    // Background GL uploads: starts a loader thread with a context shared with the
+    // main one. Its completions are polled every frame before the update callback.
+    bool EnableUploadThread();
+    GLUploadThread* GetUploadThread() { return m_uploadThread.get(); }
+    
+    // Timing and resolution stats for the last completed frame
+    const FrameStats& GetFrameStats() const { return m_frameStats; }
 
 private:
     void Update(float deltaTime);
     void Render();
     void HandleResize();
+    void BeginSceneRender();
+    void EndSceneRender();
 
     // Core subsystems
     Window m_window;        // SDL window and event polling
     Input m_input;          // Keyboard/mouse state management
     GLContext m_glContext;  // OpenGL rendering context
     
+    // Frame timing and dynamic resolution
+    GpuTimer m_gpuTimer;
+    FrameStats m_frameStats;
+    std::unique_ptr<DynamicResolution> m_dynamicResolution;
+    std::unique_ptr<RenderTarget> m_sceneTarget;  // Scaled render target (dynamic resolution only)
+    
+    // Shared-context loader thread (declared after m_glContext so it stops first)
+    std::unique_ptr<GLUploadThread> m_uploadThread;
+    
     // Game logic callbacks
     UpdateCallback m_updateCallback;
     RenderCallback m_renderCallback;
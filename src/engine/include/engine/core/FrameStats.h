@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * Per-frame timing and rendering statistics, filled in by the Engine.
+ * Intended for debug overlays and logging.
+ */
+struct FrameStats {
+    uint64_t frameIndex = 0;
+    float cpuTimeMs = 0.0f;    // Update + render time, excluding frame limiter sleep
+    float gpuTimeMs = 0.0f;    // GPU render time, reported a few frames late (0 if unknown)
+    float renderScale = 1.0f;  // Internal resolution scale (1.0 = native)
+    int renderWidth = 0;       // Internal render resolution in pixels
+    int renderHeight = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Fixed-size pool of worker threads consuming a FIFO job queue.
+ * Jobs must not touch OpenGL - only the thread owning the context may.
+ *
+ * Usage:
+ *   ThreadPool pool;                  // one worker per spare core
+ *   pool.Submit([] { DecodeSomething(); });
+ *   pool.Wait();                      // block until the queue drains
+ */
+class ThreadPool {
+public:
+    using Job = std::function<void()>;
+
+    // threadCount = 0 picks (logical cores - 1), at least 1
+    explicit ThreadPool(size_t threadCount = 0);
+
+    // Finishes queued jobs, then joins all workers
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a job for any worker
+    void Submit(Job job);
+
+    // Block until all submitted jobs have finished
+    void Wait();
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+private:
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    size_t m_activeJobs = 0;
+    bool m_stopping = false;
+
+    void WorkerLoop();
+};
+
+} // namespace engine
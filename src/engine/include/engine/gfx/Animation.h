@@ -1,5 +1,6 @@
 #pragma once
 
+#include "engine/gfx/SpriteId.h"
 #include <string>
 #include <vector>
 
@@ -9,6 +10,7 @@ namespace engine {
 struct AnimationFrame {
     std::string spriteName;  // Name of sprite in the sprite sheet
     float duration;          // How long this frame displays (seconds)
+    SpriteId spriteId = INVALID_SPRITE_ID;  // Resolved by AnimationController from spriteName
 
     AnimationFrame() : spriteName(), duration(0.1f) {}
     AnimationFrame(const std::string& name, float dur) : spriteName(name), duration(dur) {}
@@ -2,12 +2,17 @@
 
 #include "engine/gfx/Animation.h"
 #include "engine/gfx/SpriteSheet.h"
+#include "engine/utils/NameTable.h"
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace engine {
 
 // Controls animation playback from a sprite sheet, managing frame timing and transitions
+// Frame sprite names are resolved to SpriteIds whenever animations or the sheet change
+// (including sprites added to the sheet later, see SpriteSheet::GetVersion()),
+// so Update/GetCurrentSprite never hash strings. Per-frame code should also use
+// AnimationIds (FindAnimation once, then Play/PlayIfNot with the ID).
 class AnimationController {
 public:
     AnimationController() = default;
@@ -19,19 +24,28 @@ public:
     AnimationController(AnimationController&&) = default;
     AnimationController& operator=(AnimationController&&) = default;
 
-    // Sets the sprite sheet to use for all animations
-    void SetSpriteSheet(const SpriteSheet* sheet) { m_spriteSheet = sheet; }
+    // Sets the sprite sheet to use for all animations (resolves frame sprite IDs)
+    void SetSpriteSheet(const SpriteSheet* sheet);
 
-    // Adds an animation (copies the animation data)
-    void AddAnimation(const Animation& animation);
+    // Adds an animation (copies the animation data), returns its ID
+    // Re-adding a name replaces the animation and keeps its ID
+    AnimationId AddAnimation(const Animation& animation);
+
+    // Resolves an animation name to its ID (INVALID_ANIMATION_ID if unknown)
+    AnimationId FindAnimation(const std::string& name) const;
+
+    // Resolves a precomputed name hash (constexpr HashString("walk")) to its ID
+    AnimationId FindAnimation(uint64_t nameHash) const;
 
     // Loads animations from a JSON file (see format below)
     bool LoadAnimations(const std::string& jsonPath);
 
-    // Plays the named animation from the beginning
+    // Plays the animation from the beginning
+    void Play(AnimationId id);
     void Play(const std::string& name);
 
     // Plays if not already playing this animation (avoids restart)
+    void PlayIfNot(AnimationId id);
     void PlayIfNot(const std::string& name);
 
     // Stops playback, resets to first frame
@@ -49,6 +63,9 @@ public:
     // Returns the current sprite to render (or nullptr if none)
     const Sprite* GetCurrentSprite() const;
 
+    // Returns the current sprite's ID in the sprite sheet
+    SpriteId GetCurrentSpriteId() const;
+
     // Returns the name of the current sprite (for debugging)
     const std::string& GetCurrentSpriteName() const;
 
@@ -58,7 +75,10 @@ public:
     bool IsFinished() const { return m_finished; }
 
     // Returns current animation name (empty if none)
-    const std::string& GetCurrentAnimationName() const { return m_currentAnimation; }
+    const std::string& GetCurrentAnimationName() const;
+
+    // Returns current animation ID (INVALID_ANIMATION_ID if none)
+    AnimationId GetCurrentAnimationId() const { return m_currentAnimation; }
 
     // Returns current frame index
     size_t GetCurrentFrameIndex() const { return m_currentFrame; }
@@ -69,9 +89,11 @@ public:
 
 private:
     const SpriteSheet* m_spriteSheet = nullptr;
-    std::unordered_map<std::string, Animation> m_animations;
+    mutable uint64_t m_sheetVersion = 0;          // Sheet version the frame IDs were resolved against
+    mutable std::vector<Animation> m_animations;  // Indexed by AnimationId
+    NameTable m_animationNames;           // Name <-> AnimationId
 
-    std::string m_currentAnimation;
+    AnimationId m_currentAnimation = INVALID_ANIMATION_ID;
     size_t m_currentFrame = 0;
     float m_frameTimer = 0.0f;
     float m_speed = 1.0f;
@@ -82,6 +104,8 @@ private:
 
     const Animation* GetCurrentAnimation() const;
     void AdvanceFrame();
+    void ResolveSprites(Animation& animation, bool logMissing = true) const;
+    void SyncWithSheet() const;
 };
 
 /*
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine {
+
+/**
+ * Cooked texture format (.btex)
+ * Pixels are stored exactly as OpenGL wants them (bottom row first),
+ * so loading is a memory map plus a direct upload - no decode, no flip.
+ *
+ * File layout (little-endian):
+ *   BtexHeader
+ *   mip level 0 pixels
+ *   mip level 1 pixels
+ *   ...               (tightly packed, levels halve down to 1x1)
+ *
+ * Produced offline by the boxer_texcook tool.
+ */
+
+constexpr char BTEX_MAGIC[4] = { 'B', 'T', 'E', 'X' };
+constexpr uint16_t BTEX_VERSION = 1;
+
+// Pixel payload format (block-compressed formats can be added here)
+enum class BtexFormat : uint16_t {
+    RGBA8 = 1   // 4 bytes per pixel
+};
+
+struct BtexHeader {
+    char magic[4];        // "BTEX"
+    uint16_t version;     // BTEX_VERSION
+    uint16_t format;      // BtexFormat
+    uint32_t width;       // Level 0 size in pixels
+    uint32_t height;
+    uint32_t mipLevels;   // Levels stored (>= 1)
+    uint32_t reserved;
+    uint64_t dataSize;    // Payload bytes following the header
+};
+static_assert(sizeof(BtexHeader) == 32, "BtexHeader layout must stay stable");
+
+// Max levels a file may carry (enough for 65536x65536)
+constexpr int BTEX_MAX_LEVELS = 17;
+
+/**
+ * Non-owning view of a cooked texture in memory (usually a mapped file)
+ */
+struct CookedTextureView {
+    const BtexHeader* header = nullptr;
+    const uint8_t* levels[BTEX_MAX_LEVELS] = {};
+    int levelCount = 0;
+    int width = 0;
+    int height = 0;
+};
+
+namespace CookedTexture {
+
+    // Bytes used by one level of the given size
+    size_t GetLevelSize(BtexFormat format, int width, int height);
+
+    // Validate a .btex image in memory and locate its mip levels
+    // Returns false if the data is truncated or not a supported .btex
+    bool Parse(const uint8_t* data, size_t size, CookedTextureView& outView);
+
+    // Write RGBA8 pixels (bottom row first) as a .btex file
+    // When generateMips is set, the full chain is built with a box filter
+    bool Write(const std::string& path, const uint8_t* pixels, int width, int height,
+               bool generateMips);
+
+    // Halve RGBA8 pixels with a 2x2 box filter into dst (dstWidth * dstHeight * 4 bytes)
+    // Builds mip chains on the CPU, for Write and for textures refreshed a region at a time
+    void Downsample(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth, int dstHeight);
+
+    // "assets/hero.png" -> "assets/hero.btex"
+    std::string GetCookedPath(const std::string& sourcePath);
+
+    // True if path already names a .btex file
+    bool IsCookedPath(const std::string& path);
+
+} // namespace CookedTexture
+
+} // namespace engine
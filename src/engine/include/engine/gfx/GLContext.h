@@ -15,6 +15,13 @@ public:
     // Swap front and back buffers to display rendered frame
     void SwapBuffers(SDL_Window* window);
 
+    // Create a second context sharing textures, buffers and sync objects with this one
+    // (for a loader thread). This context stays current on the calling thread.
+    // The caller owns the result (SDL_GL_DestroyContext); nullptr on failure.
+    SDL_GLContext CreateSharedContext(SDL_Window* window);
+
+    SDL_GLContext GetHandle() const { return m_context; }
+
 private:
     SDL_GLContext m_context = nullptr;  // OpenGL context handle
 };
@@ -51,9 +51,34 @@ extern void (APIENTRY *glGenTextures)(GLsizei n, GLuint* textures);
 extern void (APIENTRY *glDeleteTextures)(GLsizei n, const GLuint* textures);
 extern void (APIENTRY *glBindTexture)(GLenum target, GLuint texture);
 extern void (APIENTRY *glTexImage2D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+extern void (APIENTRY *glTexSubImage2D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels);
+extern void (APIENTRY *glTexImage3D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels);
+extern void (APIENTRY *glTexSubImage3D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels);
 extern void (APIENTRY *glTexParameteri)(GLenum target, GLenum pname, GLint param);
 extern void (APIENTRY *glActiveTexture)(GLenum texture);
 extern void (APIENTRY *glGenerateMipmap)(GLenum target);
+extern void (APIENTRY *glTexStorage2D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);  // Optional (GL 4.2 / ARB_texture_storage), may be null
+
+// Framebuffer functions
+extern void (APIENTRY *glGenFramebuffers)(GLsizei n, GLuint* framebuffers);
+extern void (APIENTRY *glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
+extern void (APIENTRY *glBindFramebuffer)(GLenum target, GLuint framebuffer);
+extern void (APIENTRY *glFramebufferTexture2D)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+extern GLenum (APIENTRY *glCheckFramebufferStatus)(GLenum target);
+extern void (APIENTRY *glBlitFramebuffer)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+
+// Query functions (GPU timing)
+extern void (APIENTRY *glGenQueries)(GLsizei n, GLuint* ids);
+extern void (APIENTRY *glDeleteQueries)(GLsizei n, const GLuint* ids);
+extern void (APIENTRY *glBeginQuery)(GLenum target, GLuint id);
+extern void (APIENTRY *glEndQuery)(GLenum target);
+extern void (APIENTRY *glGetQueryObjectiv)(GLuint id, GLenum pname, GLint* params);
+extern void (APIENTRY *glGetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params);
+
+// Sync objects (background uploads)
+extern GLsync (APIENTRY *glFenceSync)(GLenum condition, GLbitfield flags);
+extern GLenum (APIENTRY *glClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+extern void (APIENTRY *glDeleteSync)(GLsync sync);
 
 } // namespace engine
 
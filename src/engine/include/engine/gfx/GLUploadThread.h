@@ -0,0 +1,94 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_opengl.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace engine {
+
+class GLContext;
+
+/**
+ * Dedicated thread with its own GL context, shared with the main context.
+ * Texture and buffer uploads submitted here run off the render thread; each
+ * job is followed by a fence (glFenceSync), and its completion callback only
+ * runs on the render thread once the GPU has finished the upload.
+ * The render thread therefore never sees half-uploaded objects.
+ *
+ * Only objects shared between contexts may be created in jobs: textures,
+ * buffers, shaders, sync objects. Container objects (VAOs, framebuffers)
+ * must still be created on the render thread.
+ *
+ * Usage:
+ *   uploader.Start(window, glContext);
+ *   uploader.Submit([data] { texture = std::make_shared<Texture2D>(*data); },
+ *                   [&](bool uploaded) { if (uploaded) ReadyToUse(texture); });
+ *   uploader.Poll();   // once per frame on the render thread
+ */
+class GLUploadThread {
+public:
+    using Job = std::function<void()>;
+    using Completion = std::function<void(bool uploaded)>;  // false: the upload never ran
+
+    GLUploadThread() = default;
+    ~GLUploadThread();
+
+    // Non-copyable
+    GLUploadThread(const GLUploadThread&) = delete;
+    GLUploadThread& operator=(const GLUploadThread&) = delete;
+
+    // Create the shared context and start the thread (call on the render thread,
+    // after LoadGLFunctions). Returns false if shared contexts are unavailable.
+    bool Start(SDL_Window* window, GLContext& context);
+
+    // Join the thread and destroy its context (render thread)
+    // Completions of uploads that ran are run once their fences signal;
+    // jobs not yet run are skipped and their completions run with false.
+    void Stop();
+
+    bool IsRunning() const { return m_thread.joinable(); }
+
+    // Queue GL work for the loader thread (any thread)
+    // onComplete runs in Poll() on the render thread once the GPU finished the job
+    // (or in Stop(), see there). If the thread is not running, the upload is
+    // dropped and onComplete(false) runs right away on the calling thread.
+    void Submit(Job upload, Completion onComplete = nullptr);
+
+    // Run completions whose fences have signaled, never blocks (render thread)
+    // Returns number of completions run.
+    size_t Poll();
+
+    // Jobs queued, running, or waiting for their fence
+    size_t GetPendingCount() const;
+
+private:
+    struct QueuedJob {
+        Job upload;
+        Completion onComplete;
+    };
+    struct FencedJob {
+        GLsync fence;
+        Completion onComplete;
+    };
+
+    std::thread m_thread;
+    SDL_Window* m_window = nullptr;
+    SDL_GLContext m_sharedContext = nullptr;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::deque<QueuedJob> m_jobs;
+    std::deque<FencedJob> m_fenced;  // In submission order, so fences signal front to back
+    size_t m_running = 0;
+    bool m_stopping = false;
+    bool m_accepting = false;   // Between Start() and Stop(): Submit queues jobs
+
+    void ThreadLoop();
+};
+
+} // namespace engine
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL_opengl.h>
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * Measures GPU time of a frame using GL_TIME_ELAPSED queries.
+ * Results are read back a few frames late so the CPU never waits on the GPU.
+ *
+ * Usage (once per frame):
+ *   timer.Begin();
+ *   ... draw ...
+ *   timer.End();
+ *   timer.Collect();  // picks up finished results from earlier frames
+ *   float ms = timer.GetLastTimeMs();
+ */
+class GpuTimer {
+public:
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    // Non-copyable
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // Create query objects (call after GL functions are loaded)
+    bool Init();
+
+    // Bracket the GPU work to measure
+    void Begin();
+    void End();
+
+    // Read back any finished queries (non-blocking)
+    void Collect();
+
+    // Most recent completed measurement (0 if none yet)
+    float GetLastTimeMs() const { return m_lastTimeMs; }
+    bool IsSupported() const { return m_supported; }
+
+private:
+    static constexpr int QUERY_COUNT = 4;  // Frames in flight before we drop a sample
+
+    GLuint m_queries[QUERY_COUNT] = {};
+    int m_writeIndex = 0;     // Next query to begin
+    int m_pendingCount = 0;   // Queries ended but not yet read back
+    bool m_active = false;    // Between Begin() and End()
+    bool m_supported = false;
+    float m_lastTimeMs = 0.0f;
+};
+
+} // namespace engine
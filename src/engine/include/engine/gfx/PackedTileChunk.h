@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Palette-compressed storage for one SIZE x SIZE block of tile indices.
+ *
+ * Cells hold an index into a per-chunk palette of tile values, packed at
+ * 1, 2, 4, 8 or 16 bits per cell - the smallest width that fits the palette.
+ * A chunk made of a single value (all empty, all water, ...) stores no cells
+ * at all. Typical chunks with a handful of tile types need 2-4 bits per cell
+ * instead of 32.
+ *
+ * Get and Set are O(1) (amortized for Set: a value that does not fit the
+ * current width repacks the chunk once). Bulk readers should use DecodeRow,
+ * which unpacks a whole row per call.
+ */
+class PackedTileChunk {
+public:
+    static constexpr int SIZE = 32;                 // Cells per side
+    static constexpr int CELLS = SIZE * SIZE;
+
+    explicit PackedTileChunk(int32_t value = -1);
+
+    int32_t Get(int x, int y) const { return Get(y * SIZE + x); }
+    int32_t Get(int cell) const;
+
+    // Returns true if the cell changed
+    bool Set(int x, int y, int32_t value) { return Set(y * SIZE + x, value); }
+    bool Set(int cell, int32_t value);
+
+    // Make the whole chunk one value (frees the packed cells)
+    void Fill(int32_t value);
+
+    // Unpack SIZE values of row y into out
+    void DecodeRow(int y, int32_t* out) const;
+
+    // Unpack all CELLS values (row-major) into out
+    void Decode(int32_t* out) const;
+
+    // Replace the chunk with CELLS row-major values, packed once at the final width
+    void Encode(const int32_t* values);
+
+    bool IsUniform() const { return m_bits == 0; }
+    int GetBitsPerCell() const { return m_bits; }
+    size_t GetPaletteSize() const { return m_palette.size(); }
+
+    // Bytes used by this chunk (object, palette, cells and lookup)
+    size_t GetMemoryUsage() const;
+
+private:
+    std::vector<int32_t> m_palette;                 // Palette index -> tile value
+    std::vector<uint64_t> m_words;                  // Packed cells, empty when uniform
+    std::vector<uint16_t> m_lookup;                 // Open-addressed value -> palette index + 1 (large palettes only)
+    int m_bits = 0;                                 // Bits per cell, 0 = uniform (m_palette[0])
+
+    uint32_t GetCell(int cell) const;
+    void SetCell(int cell, uint32_t paletteIndex);
+    uint32_t FindOrAddValue(int32_t value);
+    int FindValue(int32_t value) const;
+    void Repack(int bits);
+    void Compact();
+    void RebuildLookup();
+    void InsertLookup(uint32_t paletteIndex);
+};
+
+} // namespace engine
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "engine/gfx/Texture2D.h"
+#include <SDL3/SDL_opengl.h>
+#include <memory>
+
+namespace engine {
+
+/**
+ * Offscreen render target (framebuffer object with a color texture)
+ * Used to render at a different resolution than the window and
+ * scale the result onto the default framebuffer
+ */
+class RenderTarget {
+public:
+    RenderTarget(int width, int height, TextureFilter filter = TextureFilter::Linear);
+    ~RenderTarget();
+
+    // Non-copyable
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // Recreate the color attachment if the size changed
+    void Resize(int width, int height);
+
+    // Bind for rendering (also sets the viewport to the target size)
+    void Bind() const;
+
+    // Restore the default framebuffer (viewport is left unchanged)
+    static void Unbind();
+
+    // Copy the target onto the default framebuffer, stretched to the given size
+    void BlitToScreen(int screenWidth, int screenHeight) const;
+
+    // Getters
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    GLuint GetID() const { return m_framebufferID; }
+    const Texture2D* GetColorTexture() const { return m_colorTexture.get(); }
+    bool IsValid() const { return m_framebufferID != 0; }
+
+private:
+    GLuint m_framebufferID = 0;
+    std::unique_ptr<Texture2D> m_colorTexture;
+    int m_width = 0;
+    int m_height = 0;
+    TextureFilter m_filter;
+
+    void Create();
+    void Destroy();
+};
+
+} // namespace engine
@@ -35,6 +35,8 @@ class VertexBuffer;
 class IndexBuffer;
 class Camera2D;
 class Texture2D;
+class TextureHandle;
+class TileTypeTable;
 
 // Batch limits
 constexpr uint32_t MAX_QUADS = 10000;
@@ -102,6 +104,54 @@ public:
                   const Texture2D& texture, const Vec4& uvRect,
                   Flip flip, const Vec4& tint);
     
+    // Draw a texture that may still be loading (see TextureCache::LoadAsync)
+    // The placeholder texture is drawn until the handle is ready.
+    void DrawQuad(const Vec2& position, const Vec2& size, const TextureHandle& texture,
+                  const Vec4& tint = Vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    
+    // Draw a rotated, flipped sub-region of a texture that may still be loading
+    void DrawQuad(const Vec2& position, const Vec2& size, float rotation,
+                  const TextureHandle& texture, const Vec4& uvRect,
+                  Flip flip, const Vec4& tint);
+    
+    // Draw a prebuilt static mesh of QuadVertex quads (e.g. Tilemap chunks)
+    // The current batch is flushed first so draw order is kept. Vertices must
+    // use texIndex 0; the whole mesh is translated by offset and tinted.
+    // Animated tile quads (negative texIndex) pick their frame from tileTypes
+    // at GetTime(), see TileTypeTable.
+    void DrawMesh(const VertexArray& mesh, uint32_t indexCount, const Texture2D& texture,
+                  const Vec2& offset = Vec2(0.0f, 0.0f),
+                  const Vec4& tint = Vec4(1.0f, 1.0f, 1.0f, 1.0f),
+                  const TileTypeTable* tileTypes = nullptr);
+    
+    // Configure a VAO for QuadVertex data in vbo, sharing the batch index buffer
+    // (meshes may hold up to MAX_QUADS quads in the 0,1,2, 2,3,0 pattern)
+    void SetupMesh(VertexArray& mesh, const VertexBuffer& vbo) const;
+    
+    // Submit queued quads now, for callers that draw with their own shader
+    // in between (keeps draw order, the next quad starts a new batch)
+    void FlushBatch();
+    
+    // Camera matrix of the current frame (u_viewproj of the batch shader)
+    const Mat4& GetViewProjection() const { return m_viewProjection; }
+    
+    // World-space rectangle visible this frame: (minX, minY, maxX, maxY)
+    // Use it to skip geometry that is off screen before submitting it.
+    const Vec4& GetViewBounds() const { return m_viewBounds; }
+    
+    // Screen pixels per world unit this frame (the camera zoom), for picking
+    // a level of detail
+    float GetPixelsPerUnit() const { return m_pixelsPerUnit; }
+    
+    // Seconds that drive animated tiles (u_time); advance once per frame,
+    // e.g. by the scene's deltaTime, or hold it to pause them
+    void SetTime(float seconds) { m_time = seconds; }
+    float GetTime() const { return m_time; }
+    
+    // Texture drawn for handles that are pending or failed
+    // nullptr (default) uses the 1x1 white texture, i.e. a quad in the tint color
+    void SetPlaceholderTexture(const Texture2D* texture) { m_placeholderTexture = texture; }
+    
     // Check if initialized
     bool IsInitialized() const { return m_initialized; }
     
@@ -119,6 +169,7 @@ private:
     std::unique_ptr<VertexBuffer> m_quadVBO;
     std::unique_ptr<IndexBuffer> m_quadIBO;
     std::unique_ptr<Texture2D> m_defaultTexture;  // 1x1 white texture for solid colors
+    const Texture2D* m_placeholderTexture = nullptr;  // Stand-in for textures still loading
     
     // Batch state
     std::vector<QuadVertex> m_vertices;           // CPU-side vertex buffer
@@ -129,7 +180,10 @@ private:
     uint32_t m_textureSlotIndex = 1;              // 0 is reserved for default texture
     
     Mat4 m_viewProjection;
+    Vec4 m_viewBounds = Vec4(0.0f, 0.0f, 0.0f, 0.0f);
+    float m_pixelsPerUnit = 1.0f;
     Vec4 m_clearColor = Vec4(0.1f, 0.1f, 0.1f, 1.0f);  // Default dark gray
+    float m_time = 0.0f;
     bool m_initialized = false;
     
     // Flush accumulated quads to GPU
@@ -146,6 +200,12 @@ private:
                         const Vec4& color, const Texture2D* texture, const Vec4& uvRect,
                         Flip flip);
     
+    // Vertex attributes of QuadVertex for the currently bound VAO/VBO
+    static void SetQuadVertexLayout();
+    
+    // Texture to draw for a handle (placeholder while it is loading)
+    const Texture2D* ResolveHandle(const TextureHandle& texture) const;
+    
     // Initialization helpers
     void CreateQuadMesh();
     void CreateShader();
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+
+// Dense index of a sprite within its SpriteSheet (0, 1, 2, ...)
+// Resolve names once with SpriteSheet::FindSprite(), then use the ID every frame.
+using SpriteId = int32_t;
+constexpr SpriteId INVALID_SPRITE_ID = -1;
+
+// Dense index of an animation within its AnimationController
+using AnimationId = int32_t;
+constexpr AnimationId INVALID_ANIMATION_ID = -1;
+
+} // namespace engine
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "engine/math/Vec2.h"
 #include "engine/math/Vec4.h"
 #include "engine/gfx/Texture2D.h"
+#include "engine/gfx/TextureData.h"
+#include "engine/gfx/SpriteId.h"
+#include "engine/utils/NameTable.h"
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include <memory>
 
 namespace engine {
@@ -11,17 +15,47 @@ namespace engine {
 /**
  * Represents a single sprite within a sprite sheet.
  * Contains the UV rectangle for sub-texture rendering.
+ * 
+ * Trimmed sprites (atlas packed with --trim) store only the opaque part of
+ * the source image; sourceWidth/Height and trimX/Y say where it sat. Draw
+ * them with GetTrimmedQuad so animation frames of different crops stay put.
  */
 struct Sprite {
     Vec4 uvRect;       // (minU, minV, maxU, maxV) - normalized texture coordinates
-    int pixelWidth;    // Original pixel width (for aspect ratio)
-    int pixelHeight;   // Original pixel height
+    int pixelWidth;    // Pixel width of the stored region
+    int pixelHeight;   // Pixel height of the stored region
+    int sourceWidth;   // Size of the image before trimming (= pixel size if untrimmed)
+    int sourceHeight;
+    int trimX;         // Top-left of the stored region within the source image
+    int trimY;
     
-    Sprite() : uvRect(0, 0, 1, 1), pixelWidth(0), pixelHeight(0) {}
-    Sprite(const Vec4& uv, int w, int h) : uvRect(uv), pixelWidth(w), pixelHeight(h) {}
+    Sprite() : uvRect(0, 0, 1, 1), pixelWidth(0), pixelHeight(0),
+               sourceWidth(0), sourceHeight(0), trimX(0), trimY(0) {}
+    Sprite(const Vec4& uv, int w, int h) : uvRect(uv), pixelWidth(w), pixelHeight(h),
+                                           sourceWidth(w), sourceHeight(h), trimX(0), trimY(0) {}
     
+    // Aspect ratio of the untrimmed image (what the sprite is sized by)
     float GetAspectRatio() const {
-        return pixelHeight > 0 ? static_cast<float>(pixelWidth) / pixelHeight : 1.0f;
+        return sourceHeight > 0 ? static_cast<float>(sourceWidth) / sourceHeight : 1.0f;
+    }
+    
+    bool IsTrimmed() const { return pixelWidth != sourceWidth || pixelHeight != sourceHeight; }
+    
+    /**
+     * Quad to draw for the untrimmed image at center with size (world units,
+     * y up): the stored region, shrunk and shifted to where it sat.
+     */
+    void GetTrimmedQuad(const Vec2& center, const Vec2& size, Vec2& outCenter, Vec2& outSize) const {
+        if (!IsTrimmed() || sourceWidth <= 0 || sourceHeight <= 0) {
+            outCenter = center;
+            outSize = size;
+            return;
+        }
+        float scaleX = size.x / sourceWidth;
+        float scaleY = size.y / sourceHeight;
+        outSize = Vec2(pixelWidth * scaleX, pixelHeight * scaleY);
+        outCenter = Vec2(center.x + (trimX + pixelWidth * 0.5f - sourceWidth * 0.5f) * scaleX,
+                         center.y - (trimY + pixelHeight * 0.5f - sourceHeight * 0.5f) * scaleY);
     }
 };
 
@@ -29,12 +63,24 @@ struct Sprite {
  * A sprite sheet combines a texture atlas with named sprite regions.
  * Load from a JSON file that defines sprite names and their UV coordinates.
  * 
+ * Sprites are stored in a flat array indexed by SpriteId. Names are only
+ * for loading and tools: resolve them once with FindSprite() and pass the
+ * ID in per-frame code (IDs from JSON follow sorted name order).
+ * Name lookups go through a perfect hash built when loading finishes, and
+ * names written in code can be hashed at compile time:
+ *   constexpr uint64_t IDLE = HashString("player_idle");
+ *   SpriteId idle = sheet.FindSprite(IDLE);
+ * 
  * JSON format:
  * {
  *   "texture": "path/to/atlas.png",
+ *   "filter": "nearest_mipmap",   // optional: nearest, linear, nearest_mipmap, linear_mipmap
+ *   "padding": 4,                 // optional: transparent gap between sprites (pixels)
  *   "sprites": {
  *     "player_idle": { "x": 0, "y": 0, "w": 32, "h": 32 },
  *     "player_run1": { "x": 32, "y": 0, "w": 32, "h": 32 },
+ *     "player_jump": { "x": 64, "y": 0, "w": 20, "h": 28,      // Trimmed (optional):
+ *                      "trim": { "x": 6, "y": 4, "w": 32, "h": 32 } },  // offset, source size
  *     ...
  *   }
  * }
@@ -53,28 +99,66 @@ public:
     /**
      * Load sprite sheet from JSON file.
      * The JSON should contain texture path and sprite definitions.
+     * keepPixels also keeps the decoded atlas in memory (GetPixels), for
+     * CPU-side users such as Tilemap's overview textures.
      * Returns true on success.
      */
-    bool LoadFromFile(const std::string& jsonPath);
+    bool LoadFromFile(const std::string& jsonPath, bool keepPixels = false);
     
     /**
      * Create sprite sheet from existing texture with manual sprite definitions.
      * Useful for programmatic sprite sheet creation.
+     * pixels: optional CPU copy of the texture (see GetPixels)
      */
-    void SetTexture(std::shared_ptr<Texture2D> texture);
+    void SetTexture(std::shared_ptr<Texture2D> texture, std::shared_ptr<const TextureData> pixels = nullptr);
+    
+    /**
+     * Set the gap (in pixels) between sprites in the atlas.
+     * Mip levels coarser than the gap would blend neighbouring sprites
+     * together, so sampling is limited to levels where one texel
+     * still fits inside the padding (2^level <= padding).
+     */
+    void SetMipPadding(int padding);
+    int GetMipPadding() const { return m_mipPadding; }
     
     /**
      * Add a sprite region manually (pixel coordinates).
      * Coordinates are converted to normalized UVs internally.
+     * Returns the sprite's ID (re-adding a name keeps its ID).
+     */
+    SpriteId AddSprite(const std::string& name, int x, int y, int width, int height);
+    
+    /**
+     * Resolve a sprite name to its ID (load time / tools).
+     * Returns INVALID_SPRITE_ID if not found.
+     */
+    SpriteId FindSprite(const std::string& name) const;
+    
+    /**
+     * Resolve a precomputed name hash (HashString(name)) to its ID.
+     * Returns INVALID_SPRITE_ID if not found.
+     */
+    SpriteId FindSprite(uint64_t nameHash) const;
+    
+    /**
+     * Get a sprite by ID (hot path: a bounds check and an array index).
+     * Returns nullptr for invalid IDs.
      */
-    void AddSprite(const std::string& name, int x, int y, int width, int height);
+    const Sprite* GetSprite(SpriteId id) const {
+        return id >= 0 && static_cast<size_t>(id) < m_sprites.size() ? &m_sprites[id] : nullptr;
+    }
     
     /**
-     * Get a sprite by name.
+     * Get a sprite by name (hashes the name - prefer IDs in per-frame code).
      * Returns nullptr if sprite not found.
      */
     const Sprite* GetSprite(const std::string& name) const;
     
+    /**
+     * Name of a sprite ID (empty if invalid).
+     */
+    const std::string& GetSpriteName(SpriteId id) const;
+    
     /**
      * Check if a sprite exists.
      */
@@ -86,6 +170,12 @@ public:
     const Texture2D* GetTexture() const { return m_texture.get(); }
     Texture2D* GetTexture() { return m_texture.get(); }
     
+    /**
+     * CPU copy of the atlas (bottom row first), or nullptr unless loaded
+     * with keepPixels or given to SetTexture.
+     */
+    const TextureData* GetPixels() const { return m_pixels.get(); }
+    
     /**
      * Check if sprite sheet is valid (has texture).
      */
@@ -95,10 +185,23 @@ public:
      * Get number of sprites defined.
      */
     size_t GetSpriteCount() const { return m_sprites.size(); }
+    
+    /**
+     * Incremented whenever sprites or the texture change.
+     * Users caching sprite data compare it to know when to refresh.
+     */
+    uint64_t GetVersion() const { return m_version; }
 
 private:
     std::shared_ptr<Texture2D> m_texture;
-    std::unordered_map<std::string, Sprite> m_sprites;
+    std::shared_ptr<const TextureData> m_pixels;
+    std::vector<Sprite> m_sprites;   // Indexed by SpriteId
+    NameTable m_spriteNames;         // Name <-> SpriteId
+    int m_mipPadding = -1;  // -1 = unknown, mips are not restricted
+    uint64_t m_version = 0;
+    
+    void ApplyMipPadding();
+    SpriteId StoreSprite(const std::string& name, const Sprite& sprite);
 };
 
 } // namespace engine
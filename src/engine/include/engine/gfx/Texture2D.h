@@ -6,16 +6,28 @@
 
 namespace engine {
 
+struct TextureData;
+
 /**
  * Texture filtering mode
  * Nearest: Pixel-perfect, sharp edges (best for pixel art)
  * Linear: Smooth interpolation (best for high-res textures)
+ * Mipmap variants generate a mip chain on upload. Magnification behaves like the
+ * base mode, minification (camera zoomed out) samples smaller mips instead of
+ * skipping texels, which removes aliasing and is much kinder to the texture cache.
  */
 enum class TextureFilter {
-    Nearest,  // GL_NEAREST - no interpolation
-    Linear    // GL_LINEAR - bilinear interpolation
+    Nearest,        // GL_NEAREST - no interpolation
+    Linear,         // GL_LINEAR - bilinear interpolation
+    NearestMipmap,  // GL_NEAREST when magnified, GL_NEAREST_MIPMAP_LINEAR when minified
+    LinearMipmap    // GL_LINEAR when magnified, GL_LINEAR_MIPMAP_LINEAR (trilinear) when minified
 };
 
+// True for filters that sample from a mip chain
+inline bool IsMipmapped(TextureFilter filter) {
+    return filter == TextureFilter::NearestMipmap || filter == TextureFilter::LinearMipmap;
+}
+
 /**
  * 2D texture wrapper for OpenGL
  * Loads image files and manages GPU texture resources
@@ -23,11 +35,16 @@ enum class TextureFilter {
 class Texture2D {
 public:
     // Load texture from file path
+    // Cooked .btex files are memory-mapped and uploaded without decoding
     explicit Texture2D(const std::string& path, TextureFilter filter = TextureFilter::Linear);
     
     // Create texture from raw pixel data (RGBA format)
+    // Null data allocates every level uninitialized (filled later with Update/UpdateLevel)
     Texture2D(const uint8_t* data, int width, int height, TextureFilter filter = TextureFilter::Linear);
     
+    // Upload pixels decoded earlier (possibly on another thread)
+    explicit Texture2D(const TextureData& data, TextureFilter filter = TextureFilter::Linear);
+    
     ~Texture2D();
     
     // Non-copyable
@@ -42,19 +59,55 @@ public:
     void Bind(uint32_t slot = 0) const;
     static void Unbind();
     
+    /**
+     * Limit sampling to mip levels 0..level.
+     * Atlases use this so minified sprites never blend in their neighbours
+     * (see SpriteSheet padding). No effect on textures without mips.
+     */
+    void SetMaxMipLevel(int level);
+    
+    /**
+     * Overwrite a rectangle of the base level with RGBA pixels
+     * (width * height * 4 bytes, rows bottom-up). Mips are regenerated.
+     */
+    void Update(int x, int y, int width, int height, const uint8_t* data);
+    
+    /**
+     * Overwrite a rectangle of one mip level (rows bottom-up, coordinates in
+     * that level's pixels). Other levels are left alone, so callers that
+     * build their own mips can refresh a small region without regenerating
+     * the whole chain.
+     */
+    void UpdateLevel(int level, int x, int y, int width, int height, const uint8_t* data);
+    
     // Getters
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
+    int GetMipLevels() const { return m_mipLevels; }
+    TextureFilter GetFilter() const { return m_filter; }
     GLuint GetID() const { return m_textureID; }
     bool IsValid() const { return m_textureID != 0; }
+    
+    // Number of mip levels in a full chain for the given size
+    static int ComputeMipLevels(int width, int height);
 
 private:
     GLuint m_textureID = 0;
     int m_width = 0;
     int m_height = 0;
+    int m_mipLevels = 1;
+    TextureFilter m_filter = TextureFilter::Linear;
     
     // Create texture from raw RGBA data
     void CreateFromData(const uint8_t* data, int width, int height, TextureFilter filter);
+    
+    // Create texture from a prebuilt mip chain (levels[0] is full size)
+    // Missing levels are generated on the GPU when the filter needs them
+    void CreateFromLevels(const uint8_t* const* levels, int levelCount,
+                          int width, int height, TextureFilter filter);
+    
+    // Map a .btex file and upload its levels directly
+    void LoadCooked(const std::string& path, TextureFilter filter);
 };
 
 } // namespace engine
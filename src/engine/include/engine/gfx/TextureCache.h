@@ -1,41 +1,195 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "engine/gfx/Texture2D.h"
+#include "engine/gfx/TextureHandle.h"
 
 namespace engine {
 
+class ThreadPool;
+class GLUploadThread;
+
 // Caches loaded textures to prevent redundant uploads to the GPU
 // Returns shared_ptr so that multiple users can share the same texture.
+//
+// The cache keeps its own reference, so textures nobody uses any more stay
+// resident (e.g. while switching menu -> gameplay -> menu) until the estimated
+// VRAM total exceeds the memory budget. Then the least recently used unused
+// textures are released first. Textures still referenced elsewhere are never evicted.
+//
+// Preloading and LoadAsync() decode images on worker threads; GL uploads
+// happen on the thread that calls Preload()/Update() (the one owning the context),
+// or on a GLUploadThread if one is set.
+//
+// Threading: entries are keyed by the 64-bit hash of the path and split over
+// shards with their own reader/writer lock, so lookups from worker threads
+// (Get, Contains, LoadAsync) run concurrently without contending on one lock.
+// Everything that creates or destroys GL objects (Load, Preload, Update,
+// Clear, SetMemoryBudget) must be called on the GL thread - the thread that
+// constructed the cache.
 class TextureCache {
 public:
-    TextureCache() = default;
-    ~TextureCache() = default;
+    // Default amount of pixel data uploaded per Update() call
+    static constexpr size_t DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+    // Default VRAM allowed for cached textures
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+    // Number of independently locked parts of the cache (power of two)
+    static constexpr size_t SHARD_COUNT = 16;
+
+    // Debug view of one cached texture
+    struct ResidencyInfo {
+        std::string path;
+        size_t bytes;            // Estimated VRAM use
+        uint64_t lastUsedFrame;  // Last frame it was requested or referenced outside the cache
+        bool inUse;              // Referenced outside the cache (cannot be evicted)
+    };
+
+    TextureCache();
+    ~TextureCache();
 
     // Non-copyable
     TextureCache(const TextureCache&) = delete;
     TextureCache& operator=(const TextureCache&) = delete;
 
     // Loads texture & returns cached version if available
-    std::shared_ptr<Texture2D> Load(const std::string& path, 
+    // A cooked "<name>.btex" next to the source image is used instead when present
+    // GL thread only; other threads get cached textures but nullptr on a miss.
+    std::shared_ptr<Texture2D> Load(const std::string& path,
                                      TextureFilter filter = TextureFilter::Linear);
 
+    // Cached texture or nullptr, never loads (any thread)
+    std::shared_ptr<Texture2D> Get(const std::string& path);
+    bool Contains(const std::string& path) const;
+
+    // Returns immediately with a handle that becomes ready a few frames later
+    // (after the background decode and the upload in Update()).
+    // Already cached textures give a handle that is ready right away.
+    // The handle keeps the texture alive once loaded, like Load()'s shared_ptr.
+    // Safe to call from any thread.
+    TextureHandle LoadAsync(const std::string& path,
+                            TextureFilter filter = TextureFilter::Linear);
+
     // Preloads multiple textures (for loading screens)
-    void Preload(const std::vector<std::string>& paths, 
+    // Decodes in parallel and uploads as images finish; blocks until all are resident.
+    // Preloaded textures stay cached while they fit in the memory budget, even when unused.
+    void Preload(const std::vector<std::string>& paths,
                  TextureFilter filter = TextureFilter::Linear);
 
-    // Clears all cached textures
+    // Starts decoding in the background and returns immediately (any thread)
+    // Call Update() every frame to upload finished images
+    void PreloadAsync(const std::vector<std::string>& paths,
+                      TextureFilter filter = TextureFilter::Linear);
+
+    // Call once per frame: advances the frame counter, uploads decoded images
+    // until uploadBudgetBytes is used up (at least one image per call) and
+    // evicts down to the memory budget. Returns number of uploads.
+    size_t Update(size_t uploadBudgetBytes = DEFAULT_UPLOAD_BUDGET);
+
+    // Number of textures still decoding or waiting for upload
+    size_t GetPendingCount() const;
+
+    // Worker pool used for decoding (a private pool is created if none is set)
+    // The pool must outlive any decode it has been given. Set before first use.
+    void SetThreadPool(ThreadPool* pool) { m_threadPool = pool; }
+
+    // Upload decoded images from this loader thread instead of inside Update()
+    // Update() then only publishes textures whose upload fence has signaled
+    // (the upload thread must be polled before Update() each frame).
+    // Preload() keeps uploading directly since it blocks anyway.
+    void SetUploadThread(GLUploadThread* uploader) { m_uploadThread = uploader; }
+
+    // Clears all cached textures (pending LoadAsync handles are marked failed)
+    // Textures still referenced elsewhere stay alive, but are no longer tracked;
+    // drop those references on the GL thread.
     void Clear();
 
-    // Returns number of textures currently in cache (excluding expired entries)
+    // Returns number of textures currently in cache
     size_t GetCachedCount() const;
 
+    // VRAM budget for cached textures; lowering it evicts immediately
+    void SetMemoryBudget(size_t bytes);
+    size_t GetMemoryBudget() const { return m_memoryBudget; }
+
+    // Estimated VRAM held by cached textures (in use or not)
+    size_t GetResidentBytes() const { return m_residentBytes.load(std::memory_order_relaxed); }
+
+    // Number of Update() calls so far (the "frame" in lastUsedFrame)
+    uint64_t GetFrameIndex() const { return m_frameIndex.load(std::memory_order_relaxed); }
+
+    // Snapshot of all cached textures, for debug overlays and logging
+    std::vector<ResidencyInfo> GetResidency() const;
+
+    // True when called on the thread that owns the GL context
+    bool IsGLThread() const { return std::this_thread::get_id() == m_glThread; }
+
+    // VRAM estimate: width * height * bytes per pixel, +1/3 for a mip chain
+    static size_t EstimateBytes(const Texture2D& texture);
+
+    // Path that will actually be read for a source path (cooked file if usable)
+    static std::string ResolveSourcePath(const std::string& path);
+
 private:
-    std::unordered_map<std::string, std::weak_ptr<Texture2D>> m_cache;
+    struct DecodeQueue;  // Shared with worker jobs, outlives the cache if needed
+
+    // Who is waiting for a path that is being decoded
+    struct PendingLoad {
+        std::string path;
+        std::shared_ptr<TextureHandle::Slot> handle; // Requested by LoadAsync (may be null)
+    };
+
+    struct CacheEntry {
+        std::string path;                    // Kept for logs and hash collision checks
+        std::shared_ptr<Texture2D> texture;  // Cache's own reference
+        size_t bytes = 0;
+        std::atomic<uint64_t> lastUsedFrame{ 0 };  // Updated under a shared lock
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, CacheEntry> entries;
+    };
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+
+    mutable std::mutex m_pendingMutex;
+    std::unordered_map<uint64_t, PendingLoad> m_inFlight;  // Paths queued for decoding
+
+    size_t m_memoryBudget = DEFAULT_MEMORY_BUDGET;
+    std::atomic<size_t> m_residentBytes{ 0 };
+    std::atomic<uint64_t> m_frameIndex{ 0 };
+    std::thread::id m_glThread;
+
+    std::shared_ptr<DecodeQueue> m_decodeQueue;
+    ThreadPool* m_threadPool = nullptr;
+    std::unique_ptr<ThreadPool> m_ownedPool;
+    GLUploadThread* m_uploadThread = nullptr;
+    std::shared_ptr<bool> m_alive;  // Upload completions check this before touching the cache
+
+    Shard& GetShard(uint64_t key) { return m_shards[key & (SHARD_COUNT - 1)]; }
+    const Shard& GetShard(uint64_t key) const { return m_shards[key & (SHARD_COUNT - 1)]; }
+
+    ThreadPool& GetThreadPool();
+    PendingLoad& QueueDecode(uint64_t key, const std::string& path, TextureFilter filter);
+    size_t UploadDecoded(size_t uploadBudgetBytes, bool useUploadThread);
+    void SubmitUpload(uint64_t key, TextureFilter filter, TextureData&& data, uint64_t generation);
+    void FinishLoad(uint64_t key, std::shared_ptr<Texture2D> texture);
+
+    // Cached texture (marked as used this frame), nullptr on miss
+    std::shared_ptr<Texture2D> Find(uint64_t key, const std::string& path);
+    void Insert(uint64_t key, const std::string& path, const std::shared_ptr<Texture2D>& texture);
+    void EvictToBudget();
 };
 
 } // namespace engine
-
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+/**
+ * CPU-side texture pixels, ready for upload.
+ * Loading is thread-safe, so images can be decoded on worker threads
+ * and handed to the GL thread afterwards (see TextureCache::Preload).
+ */
+struct TextureData {
+    std::vector<uint8_t> pixels;  // RGBA8, bottom row first, mip levels packed back to back
+    int width = 0;                // Level 0 size in pixels
+    int height = 0;
+    int levelCount = 0;           // 0 = nothing loaded
+
+    bool IsValid() const { return levelCount > 0; }
+
+    // Total GPU bytes of the stored levels
+    size_t GetSizeBytes() const { return pixels.size(); }
+
+    /**
+     * Decode an image file (PNG, JPG, ... or cooked .btex).
+     * Safe to call from any thread - does not touch OpenGL.
+     * Returns false and logs on failure.
+     */
+    bool LoadFromFile(const std::string& path);
+
+    // Pointer to the pixels of a mip level (nullptr if out of range)
+    const uint8_t* GetLevelData(int level) const;
+};
+
+} // namespace engine
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+class Texture2D;
+
+/**
+ * Reference to a texture that may still be loading (see TextureCache::LoadAsync).
+ * Cheap to copy - all copies share the same load state.
+ *
+ * While pending (or if loading failed) Get() returns nullptr, and
+ * Renderer2D draws the placeholder texture instead, so late textures
+ * simply pop in a few frames later.
+ *
+ * State and texture may be queried from any thread. Loads are completed on
+ * the GL thread (the one calling TextureCache::Update()), which is also
+ * where pending OnReady() callbacks run.
+ */
+class TextureHandle {
+public:
+    enum class State : uint8_t {
+        Empty,    // Default-constructed, refers to nothing
+        Pending,  // Decoding or waiting for upload
+        Ready,    // Texture uploaded and usable
+        Failed    // File missing or invalid
+    };
+
+    using ReadyCallback = std::function<void(const TextureHandle& handle)>;
+
+    TextureHandle() = default;
+
+    State GetState() const;
+    bool IsValid() const { return m_slot != nullptr; }
+    bool IsPending() const { return GetState() == State::Pending; }
+    bool IsReady() const { return GetState() == State::Ready; }
+    bool IsFailed() const { return GetState() == State::Failed; }
+
+    // Loaded texture, nullptr until ready
+    Texture2D* Get() const;
+    std::shared_ptr<Texture2D> GetShared() const;
+
+    // Loaded texture, or fallback while pending/failed
+    const Texture2D& GetOr(const Texture2D& fallback) const;
+
+    // Path the handle was requested with (empty for default handles)
+    const std::string& GetPath() const;
+
+    // Run callback once the load finishes (successfully or not)
+    // Runs inside TextureCache::Update(), or immediately on the calling thread
+    // if already finished.
+    void OnReady(ReadyCallback callback) const;
+
+private:
+    friend class TextureCache;
+
+    struct Slot {
+        std::string path;
+        std::atomic<State> state{ State::Pending };
+        std::shared_ptr<Texture2D> texture;   // Written once, before state leaves Pending
+        std::mutex callbackMutex;
+        std::vector<ReadyCallback> callbacks;
+    };
+
+    std::shared_ptr<Slot> m_slot;
+
+    explicit TextureHandle(std::shared_ptr<Slot> slot) : m_slot(std::move(slot)) {}
+
+    // Finish a pending slot (texture == nullptr marks it failed) and fire callbacks
+    static void Resolve(const std::shared_ptr<Slot>& slot, std::shared_ptr<Texture2D> texture);
+};
+
+} // namespace engine
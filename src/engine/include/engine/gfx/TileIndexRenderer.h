@@ -0,0 +1,87 @@
+#pragma once
+
+#include "engine/math/Vec2.h"
+#include "engine/math/Vec4.h"
+#include <SDL3/SDL_opengl.h>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace engine {
+
+class Renderer2D;
+class Shader;
+class Texture2D;
+class TileTypeTable;
+class VertexArray;
+class VertexBuffer;
+
+/**
+ * GPU-driven tile grid renderer (used by Tilemap's IndexTexture mode).
+ *
+ * The grid lives in an R16UI array texture with one texel per tile and one
+ * slice per layer, and tile types map to atlas UV rects (or animation
+ * frames, picked by Renderer2D::GetTime()) through a TileTypeTable.
+ *
+ * Drawing is a single quad over the visible part of the map; the fragment
+ * shader walks the layers back to front, finds the tile under the pixel in
+ * each (with that layer's offset) and blends them.
+ * CPU cost per frame is constant no matter how large the map is or how far
+ * the camera zooms out.
+ *
+ * Tile indices >= EMPTY_TEXEL (and negative ones) are not drawn.
+ */
+class TileIndexRenderer {
+public:
+    static constexpr uint16_t EMPTY_TEXEL = 0xFFFF;
+    static constexpr int MAX_LAYERS = 8;
+
+    // One layer as drawn this frame
+    struct LayerDraw {
+        int layer = 0;                  // Texture slice
+        Vec2 offset;                    // World position of the layer's origin
+        float opacity = 1.0f;
+    };
+
+    TileIndexRenderer();
+    ~TileIndexRenderer();
+
+    // Non-copyable
+    TileIndexRenderer(const TileIndexRenderer&) = delete;
+    TileIndexRenderer& operator=(const TileIndexRenderer&) = delete;
+
+    /**
+     * Create the textures and shader for a width x height grid of layerCount layers.
+     * Returns false if the grid exceeds GL_MAX_TEXTURE_SIZE or setup fails.
+     */
+    bool Init(int width, int height, int layerCount = 1);
+    bool IsValid() const { return m_indexTexture != 0; }
+    int GetLayerCount() const { return m_layerCount; }
+
+    // Upload one whole layer (row-major, width * height tiles)
+    void UploadTiles(int layer, const int32_t* tiles);
+
+    // Update a single tile (one-texel glTexSubImage3D)
+    void UpdateTile(int layer, int x, int y, int32_t tileIndex);
+
+    /**
+     * Draw layers (back to front, at most MAX_LAYERS) in one pass with the renderer's camera.
+     * Flushes the renderer's batch first so draw order is kept.
+     */
+    void Draw(Renderer2D& renderer, const Texture2D& atlas, const TileTypeTable& tileTypes,
+              const std::vector<LayerDraw>& layers, float tileSize);
+
+private:
+    GLuint m_indexTexture = 0;
+    int m_width = 0;
+    int m_height = 0;
+    int m_layerCount = 0;
+    std::unique_ptr<Shader> m_shader;
+    std::unique_ptr<VertexArray> m_quadVAO;
+    std::unique_ptr<VertexBuffer> m_quadVBO;
+
+    void Destroy();
+    static uint16_t ToTexel(int32_t tileIndex);
+};
+
+} // namespace engine
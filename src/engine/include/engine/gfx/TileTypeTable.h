@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine/math/Vec4.h"
+#include <SDL3/SDL_opengl.h>
+#include <vector>
+#include <cstdint>
+
+namespace engine {
+
+/**
+ * GPU lookup table of tile types, shared by both Tilemap render paths.
+ *
+ * One RGBA32F row: texel t describes tile type t as a static atlas uvRect,
+ * a hidden type, or the header of an animation whose frames are stored
+ * after the type entries. Shaders pick the current frame with TileTypeRect
+ * (see GLSL) from a time uniform and a per-cell phase, so an animated tile
+ * is static geometry: nothing is rewritten per tile or per frame on the CPU.
+ *
+ * Animated quads in chunk meshes carry the corner within the tile (0/1) as
+ * texCoord and EncodeAnimatedTexIndex(...) as texIndex; Renderer2D::DrawMesh
+ * resolves them in its vertex shader.
+ */
+class TileTypeTable {
+public:
+    static constexpr int PHASE_STEPS = 256;             // Phase buckets per animation cycle
+    static constexpr int32_t MAX_ANIMATED_TYPE = 0xFFFF; // Larger types can't be packed in texIndex
+
+    struct Frame {
+        Vec4 uvRect;
+        float duration = 0.1f;          // Seconds
+    };
+
+    // One tile type as uploaded
+    struct Entry {
+        bool visible = false;
+        Vec4 uvRect = Vec4(0.0f, 0.0f, 1.0f, 1.0f);    // Static types
+        std::vector<Frame> frames;      // Two or more: animated (looping)
+        float phaseSpread = 0.0f;       // Fraction of the cycle tiles are spread over
+    };
+
+    TileTypeTable();
+    ~TileTypeTable();
+
+    // Non-copyable
+    TileTypeTable(const TileTypeTable&) = delete;
+    TileTypeTable& operator=(const TileTypeTable&) = delete;
+
+    // Replace the table (creates the texture on first use)
+    void Upload(const std::vector<Entry>& types);
+
+    void Bind(uint32_t slot) const;
+    bool IsValid() const { return m_texture != 0; }
+    int GetTypeCount() const { return m_typeCount; }
+
+    // Phase bucket of a grid cell (0..PHASE_STEPS-1), the same as TilePhase in GLSL
+    static uint32_t TilePhase(int x, int y) {
+        uint32_t h = static_cast<uint32_t>(x) * 0x8DA6B343u ^ static_cast<uint32_t>(y) * 0xD8163841u;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        return h & (PHASE_STEPS - 1);
+    }
+
+    // QuadVertex::texIndex for an animated tile quad (exact in a float up to MAX_ANIMATED_TYPE)
+    static float EncodeAnimatedTexIndex(int32_t tileIndex, uint32_t phase) {
+        return -1.0f - static_cast<float>(static_cast<uint32_t>(tileIndex) * PHASE_STEPS + phase);
+    }
+
+    // GLSL 3.30 helpers TilePhase(ivec2) and TileTypeRect(table, type, phase, time),
+    // to be inserted after the #version line
+    static const char* GLSL;
+
+private:
+    GLuint m_texture = 0;
+    int m_typeCount = 0;
+    int m_texelCount = 0;
+};
+
+} // namespace engine
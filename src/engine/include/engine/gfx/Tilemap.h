@@ -1,29 +1,128 @@
 #pragma once
 
 #include "engine/math/Vec2.h"
+#include "engine/math/Vec4.h"
+#include "engine/gfx/SpriteId.h"
+#include "engine/gfx/Animation.h"
+#include "engine/gfx/PackedTileChunk.h"
+#include "engine/gfx/TileTypeTable.h"
+#include "engine/physics/Collision.h"
 #include <vector>
 #include <string>
+#include <memory>
 #include <cstdint>
 
 namespace engine {
 
 class SpriteSheet;
 class Renderer2D;
+class Texture2D;
+struct TextureData;
+class VertexArray;
+class VertexBuffer;
+class TileIndexRenderer;
+class ThreadPool;
+struct QuadVertex;
+
+/**
+ * How Tilemap::Draw turns tiles into pixels.
+ * Chunks:       one static mesh per visible chunk (one quad per tile)
+ * IndexTexture: the grid is an R16UI texture drawn as one quad; the fragment
+ *               shader looks up tile and UV per pixel. Constant CPU cost for
+ *               huge maps and far zoom-outs, tile indices must stay below 65535.
+ */
+enum class TilemapRenderMode {
+    Chunks,
+    IndexTexture
+};
+
+/**
+ * Result of Tilemap::Raycast
+ */
+struct TileRaycastHit {
+    bool hit = false;
+    int cellX = -1;                  // Grid cell that was hit
+    int cellY = -1;
+    int32_t tile = -1;               // Tile index in that cell
+    Vec2 point;                      // World position where the ray entered the cell
+    Vec2 normal;                     // Face normal of the cell (zero if the ray started inside it)
+    float distance = 0.0f;           // World distance from the origin to point
+};
+
+// One ray of a batched raycast (direction need not be normalized)
+struct TileRay {
+    Vec2 origin;
+    Vec2 direction;
+    float maxDistance = 0.0f;
+};
 
 /**
  * A 2D grid of tiles that renders efficiently using batch rendering.
  * Each tile is an index into a sprite sheet.
  * 
+ * The grid is split into CHUNK_SIZE x CHUNK_SIZE chunks, each with a static
+ * vertex buffer that is only rebuilt after SetTile/Fill/sprite changes touch
+ * it. Draw only visits chunks overlapping the renderer's view, so the cost
+ * per frame depends on screen size, not map size. Meshes of chunks that
+ * have not been on screen for a while are released again.
+ * 
+ * Tiles are stored per chunk, palette-compressed (PackedTileChunk): a few
+ * bits per cell for typical chunks and next to nothing for uniform ones
+ * (all empty, all water). GetTile/SetTile stay O(1); bulk readers should
+ * use GetTileRow, which decodes a chunk row at a time.
+ * 
+ * Collision: tile types can be flagged solid. Contiguous solid tiles are
+ * merged greedily into a few rectangles per chunk, rebuilt lazily for just
+ * the chunks whose solidity changed. QueryColliders returns the rectangles
+ * of the chunks inside a region (typically the swept bounds of a moving
+ * box), and MoveAndSlide resolves a move against them, so collision cost
+ * depends on the size of the mover, not the size of the map.
+ * QuerySolidTiles still returns one box per solid tile when that is needed.
+ * 
+ * Raycast/LineOfSight walk the grid cell by cell (Amanatides-Woo DDA) over
+ * the solid tiles of the collision layer, so a ray costs the cells it
+ * crosses. RaycastBatch spreads many rays over a ThreadPool.
+ * 
+ * Tile types are resolved to sprite UVs when the mapping or sheet changes
+ * (and again whenever SpriteSheet::GetVersion() moves), so building a chunk
+ * never looks sprites up.
+ * 
+ * Zoomed far out (below SetLodZoom), tiles shrink below a few pixels and
+ * per-tile quads are wasted work. Draw then switches to overviews: each
+ * visible chunk is one quad textured from a slot in a shared atlas page,
+ * with one texel per tile (every tile type averaged from its sprite in the
+ * sheet's CPU-side pixels, see SpriteSheet::LoadFromFile keepPixels).
+ * Only visible chunks get a slot (4 KiB plus mips per chunk and layer),
+ * edits only mark their chunk, and only dirty visible chunks are
+ * re-encoded, mips included, on the next zoomed-out Draw. Slots of chunks
+ * that stay off screen are released like chunk meshes.
+ * 
+ * Animated tiles (water, lava): SetTileAnimation gives a tile type a looping
+ * frame list. Both render paths pick the frame in the shader from
+ * Renderer2D::GetTime() plus a per-cell phase (TileTypeTable), so animated
+ * tiles stay part of the static chunk meshes and cost nothing per frame.
+ * 
+ * A map can have several layers sharing the same grid and tile types (e.g.
+ * background, midground, foreground). Each layer has a parallax factor,
+ * opacity and z order; Draw renders all of them in one call with the same
+ * camera, offsetting each layer on the GPU. Layer 0 always exists and is
+ * what the layer-less SetTile/GetTile/Fill overloads use.
+ * 
  * Usage:
  *   Tilemap map(20, 15, 32.0f);  // 20x15 tiles, 32px each
  *   map.SetSpriteSheet(&spriteSheet);
  *   map.SetTileSprite(0, "grass");   // Tile index 0 = "grass" sprite
  *   map.SetTile(5, 3, 0);            // Place grass at (5, 3)
+ *   int clouds = map.AddLayer(Vec2(0.5f, 0.5f), 0.8f, -1);  // Slow, behind layer 0
+ *   map.SetTile(clouds, 2, 10, 3);
  *   map.Draw(renderer, offset);
  */
 class Tilemap {
 public:
     static constexpr int32_t EMPTY_TILE = -1;
+    static constexpr int CHUNK_SIZE = 32;  // Tiles per chunk side
+    static constexpr int MAX_LAYERS = 8;   // Layers drawn in one pass
+    static_assert(CHUNK_SIZE == PackedTileChunk::SIZE, "Render chunks and storage chunks must match");
     
     /**
      * Create a tilemap with given dimensions.
@@ -32,15 +131,15 @@ public:
      * @param tileSize Size of each tile in world units (pixels)
      */
     Tilemap(int width, int height, float tileSize);
-    ~Tilemap() = default;
+    ~Tilemap();
     
     // Non-copyable, movable
     Tilemap(const Tilemap&) = delete;
     Tilemap& operator=(const Tilemap&) = delete;
-    Tilemap(Tilemap&&) = default;
-    Tilemap& operator=(Tilemap&&) = default;
+    Tilemap(Tilemap&&);
+    Tilemap& operator=(Tilemap&&);
     
-    // Sprite sheet binding
+    // Sprite sheet binding (re-resolves sprite names set with SetTileSprite)
     void SetSpriteSheet(const SpriteSheet* spriteSheet);
     const SpriteSheet* GetSpriteSheet() const { return m_spriteSheet; }
     
@@ -51,37 +150,225 @@ public:
      */
     void SetTileSprite(int32_t tileIndex, const std::string& spriteName);
     
+    /**
+     * Map a tile index to a sprite ID in the sprite sheet.
+     */
+    void SetTileSprite(int32_t tileIndex, SpriteId spriteId);
+    
+    /**
+     * Sprite ID drawn for a tile index (INVALID_SPRITE_ID if unmapped).
+     */
+    SpriteId GetTileSprite(int32_t tileIndex) const;
+    
+    /**
+     * Animate a tile type with a looping frame list (sprite names and
+     * durations; Animation::loop is ignored). Replaces the type's sprite
+     * while set. Tile indices above TileTypeTable::MAX_ANIMATED_TYPE can't
+     * be animated.
+     * @param phaseSpread 0 = every tile of the type in step, 1 = tiles start
+     *                    spread over the whole cycle (per-cell phase)
+     */
+    void SetTileAnimation(int32_t tileIndex, const Animation& animation, float phaseSpread = 0.0f);
+    void ClearTileAnimation(int32_t tileIndex);
+    bool IsTileAnimated(int32_t tileIndex) const;
+    
+    // Resolved tile types on the GPU (uploaded on demand, needs a GL context);
+    // pass it to Renderer2D::DrawMesh for meshes built with AppendTileQuads
+    const TileTypeTable* GetTileTypeTable() const;
+    
+    // Solid flags per tile type (all types start non-solid)
+    void SetTileSolid(int32_t tileIndex, bool solid);
+    bool IsTileSolid(int32_t tileIndex) const {
+        return static_cast<uint32_t>(tileIndex) < m_tileSolid.size() && m_tileSolid[tileIndex] != 0;
+    }
+    
+    // Layer whose tiles collide (0 by default)
+    void SetCollisionLayer(int layer);
+    int GetCollisionLayer() const { return m_collisionLayer; }
+    
+    // True if the collision layer has a solid tile at a grid position
+    bool IsSolidAt(int x, int y) const { return IsTileSolid(GetTile(m_collisionLayer, x, y)); }
+    
+    // Opaque flags per tile type, read from the collision layer (blocks sight, see FieldOfView)
+    void SetTileOpaque(int32_t tileIndex, bool opaque);
+    bool IsTileOpaque(int32_t tileIndex) const {
+        return static_cast<uint32_t>(tileIndex) < m_tileOpaque.size() && m_tileOpaque[tileIndex] != 0;
+    }
+    bool IsOpaqueAt(int x, int y) const { return IsTileOpaque(GetTile(m_collisionLayer, x, y)); }
+    
+    /**
+     * Collect world-space boxes of the solid tiles overlapping bounds.
+     * Only the tiles under bounds are visited, decoded a row at a time.
+     * @param bounds Query region (e.g. Collision::GetSweptBounds(box, delta))
+     * @param out Cleared, then filled with one box per solid tile
+     * @param offset Tilemap offset (same as passed to Draw)
+     */
+    void QuerySolidTiles(const AABB& bounds, std::vector<AABB>& out,
+                         const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    /**
+     * Like QuerySolidTiles, but returns the merged collider rectangles of
+     * the chunks under bounds (those overlapping bounds). Far fewer boxes
+     * than tiles on typical maps.
+     * Although const, this (like GetColliders and MoveAndSlide) rebuilds the
+     * collider cache of stale chunks: unlike Raycast, do not call it from
+     * several threads at once.
+     */
+    void QueryColliders(const AABB& bounds, std::vector<AABB>& out,
+                        const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    // All merged collider rectangles of the map (e.g. to feed a physics world)
+    // Updates the collider cache, so not thread-safe (see QueryColliders)
+    void GetColliders(std::vector<AABB>& out, const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    /**
+     * Move a box by delta against the solid tiles, sliding along walls
+     * (Collision::MoveAndSlide over the merged colliders in the swept bounds).
+     * Reuses an internal box list and the collider cache: not thread-safe.
+     */
+    MoveResult MoveAndSlide(const AABB& box, const Vec2& delta,
+                            const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    /**
+     * Cast a ray against the solid tiles of the collision layer.
+     * Safe to call from several threads at once as long as no thread edits the map.
+     * @param origin World-space start
+     * @param direction Ray direction (normalized internally)
+     * @param maxDistance World distance after which the ray stops
+     * @param offset Tilemap offset (same as passed to Draw)
+     */
+    TileRaycastHit Raycast(const Vec2& origin, const Vec2& direction, float maxDistance,
+                           const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    // True if no solid tile lies between two world positions
+    bool LineOfSight(const Vec2& from, const Vec2& to, const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    /**
+     * Cast many rays, split into groups across pool's workers and the
+     * calling thread. Blocks until this batch is done (other jobs on the
+     * pool are not waited for); hits[i] answers rays[i]. Safe to call from
+     * a pool worker.
+     * For line-of-sight checks use maxDistance = |to - from| and test !hit.
+     */
+    void RaycastBatch(const std::vector<TileRay>& rays, std::vector<TileRaycastHit>& hits,
+                      ThreadPool& pool, const Vec2& offset = Vec2(0.0f, 0.0f)) const;
+    
+    /**
+     * Add an empty layer with the same size as the map.
+     * @param parallax Scroll factor relative to the camera (1 = moves with
+     *                 the world, 0.5 = half speed background, 0 = fixed to screen)
+     * @param opacity  Alpha multiplier for the whole layer
+     * @param zOrder   Layers are drawn in ascending z order (ties: creation order)
+     * @return The layer index, or -1 if MAX_LAYERS is reached
+     */
+    int AddLayer(const Vec2& parallax = Vec2(1.0f, 1.0f), float opacity = 1.0f, int zOrder = 0);
+    int GetLayerCount() const { return static_cast<int>(m_layers.size()); }
+    
+    // Layer properties (take effect on the next Draw, no rebuild needed)
+    void SetLayerParallax(int layer, const Vec2& parallax);
+    void SetLayerOpacity(int layer, float opacity);
+    void SetLayerZOrder(int layer, int zOrder);
+    Vec2 GetLayerParallax(int layer) const;
+    float GetLayerOpacity(int layer) const;
+    int GetLayerZOrder(int layer) const;
+    
     /**
      * Set the tile at a grid position.
      * @param x Grid X coordinate (0 to width-1)
      * @param y Grid Y coordinate (0 to height-1)
      * @param tileIndex Tile type index, or EMPTY_TILE for no tile
      */
-    void SetTile(int x, int y, int32_t tileIndex);
+    void SetTile(int x, int y, int32_t tileIndex) { SetTile(0, x, y, tileIndex); }
+    void SetTile(int layer, int x, int y, int32_t tileIndex);
     
     /**
      * Get the tile at a grid position.
      * Returns EMPTY_TILE if out of bounds or empty.
      */
-    int32_t GetTile(int x, int y) const;
+    int32_t GetTile(int x, int y) const { return GetTile(0, x, y); }
+    int32_t GetTile(int layer, int x, int y) const;
     
     /**
-     * Fill the entire map with a single tile type.
+     * Read count tiles of a row, starting at (x, y) and going right.
+     * Decodes whole chunk rows at a time; tiles outside the map read as EMPTY_TILE.
      */
-    void Fill(int32_t tileIndex);
+    void GetTileRow(int layer, int x, int y, int count, int32_t* out) const;
     
     /**
-     * Clear the entire map (set all tiles to EMPTY_TILE).
+     * Fill a whole layer (layer 0 by default) with a single tile type.
+     */
+    void Fill(int32_t tileIndex) { Fill(0, tileIndex); }
+    void Fill(int layer, int32_t tileIndex);
+    
+    /**
+     * Exchange one chunk of a layer with tiles, which receives the old
+     * contents. Nothing is copied; the chunk is only marked for rebuilding,
+     * so chunks built on other threads (ChunkGenerator) are published in
+     * O(1). Cells past the map edge should be EMPTY_TILE.
+     */
+    void SwapChunk(int layer, int chunkX, int chunkY, PackedTileChunk& tiles);
+    
+    /**
+     * Clear the entire map (set all tiles of all layers to EMPTY_TILE).
      */
     void Clear();
     
     /**
-     * Draw the tilemap using the renderer.
+     * Draw all layers using the renderer.
+     * Only chunks inside renderer.GetViewBounds() are drawn (call between
+     * BeginFrame and EndFrame). Dirty chunks are rebuilt here.
+     * A layer with parallax p is shifted by cameraCenter * (1 - p).
      * @param renderer The 2D renderer
      * @param offset World position offset for the tilemap origin (bottom-left)
      */
     void Draw(Renderer2D& renderer, const Vec2& offset = Vec2(0.0f, 0.0f)) const;
     
+    /**
+     * Select the render path (Chunks by default).
+     * IndexTexture falls back to Chunks if the grid exceeds GL_MAX_TEXTURE_SIZE.
+     */
+    void SetRenderMode(TilemapRenderMode mode);
+    TilemapRenderMode GetRenderMode() const { return m_renderMode; }
+    
+    /**
+     * Below this zoom (Renderer2D::GetPixelsPerUnit) Draw renders each
+     * visible chunk from its overview slot as one quad, in either render
+     * mode. Needs a sprite sheet with CPU-side pixels; without them Draw
+     * keeps drawing tiles. 0 disables the overview. Default 0.25.
+     */
+    void SetLodZoom(float zoom) { m_lodZoom = zoom; }
+    float GetLodZoom() const { return m_lodZoom; }
+    
+    /**
+     * Texels per tile side in the overviews: 1 (one average color per tile)
+     * or 2 (coarse sprite detail, 4x the memory). Default 1.
+     * Changing it releases every overview slot.
+     */
+    void SetLodResolution(int texelsPerTile);
+    int GetLodResolution() const { return m_lodResolution; }
+    
+    /**
+     * Append one quad per visible tile of a block of tile indices, using this
+     * map's tile types. Lets tile data stored elsewhere (e.g. TileWorld chunks)
+     * share the sprite mapping. Vertices are placed relative to origin.
+     * @param stride Distance between rows of tiles, in tiles
+     * @param firstCellX, firstCellY Grid cell of the first tile (seeds animation phases)
+     */
+    void AppendTileQuads(const int32_t* tiles, int columns, int rows, int stride,
+                         const Vec2& origin, std::vector<QuadVertex>& vertices,
+                         int firstCellX = 0, int firstCellY = 0) const;
+    
+    // Changes whenever tile types resolve to different sprites or UVs
+    // (meshes built with AppendTileQuads are stale when it moves)
+    uint64_t GetTileTypeVersion() const;
+    
+    // Bytes used by the compressed tile storage of all layers
+    size_t GetTileMemoryUsage() const;
+    
+    // Chunk grid dimensions
+    int GetChunksX() const { return m_chunksX; }
+    int GetChunksY() const { return m_chunksY; }
+    
     // Dimensions
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
@@ -105,17 +392,128 @@ public:
     Vec2 GridToWorld(int x, int y, const Vec2& offset = Vec2(0.0f, 0.0f)) const;
 
 private:
+    // Cached GPU geometry for one CHUNK_SIZE x CHUNK_SIZE block of tiles
+    struct Chunk {
+        std::unique_ptr<VertexArray> mesh;
+        std::unique_ptr<VertexBuffer> vertices;
+        uint32_t indexCount = 0;
+        uint64_t lastDrawnFrame = 0;
+        bool dirty = true;
+        int lodSlot = -1;               // Overview atlas slot, -1 = none
+        uint64_t lodLastDrawnFrame = 0;
+        bool lodDirty = true;           // Slot texels are stale
+    };
+    
+    // Solid rectangle in chunk-local tiles
+    struct TileRect {
+        uint8_t x, y, width, height;
+    };
+    
+    // Merged colliders of one chunk of the collision layer
+    struct ColliderChunk {
+        std::vector<TileRect> rects;
+        bool dirty = true;
+    };
+    
+    // One grid of tiles plus how it is composited
+    struct Layer {
+        std::vector<PackedTileChunk> tiles;  // Per chunk, chunk grid row-major
+        Vec2 parallax = Vec2(1.0f, 1.0f);
+        float opacity = 1.0f;
+        int zOrder = 0;
+    };
+    
     int m_width;
     int m_height;
     float m_tileSize;
+    int m_chunksX;
+    int m_chunksY;
     
-    std::vector<int32_t> m_tiles;                          // Grid data (row-major)
-    std::vector<std::string> m_tileSprites;                // Tile index → sprite name
+    // Sprite data of one tile type, ready to be written into vertices
+    struct TileUV {
+        Vec4 uvRect = Vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        bool visible = false;  // False if unmapped or the sprite is missing
+        bool animated = false; // Two or more frames resolved
+        std::vector<TileTypeTable::Frame> frames;
+        float phaseSpread = 0.0f;
+    };
+    
+    // Frame list set with SetTileAnimation (empty: the type uses its sprite)
+    struct TileAnimation {
+        std::vector<AnimationFrame> frames;
+        float phaseSpread = 0.0f;
+    };
+    
+    std::vector<Layer> m_layers;                           // Layer 0 always exists
+    std::vector<std::string> m_tileSpriteNames;            // Tile index → sprite name (for re-resolving)
+    std::vector<TileAnimation> m_tileAnimations;           // Tile index → frames by sprite name
+    std::vector<uint8_t> m_tileSolid;                      // Tile index → solid flag
+    std::vector<uint8_t> m_tileOpaque;                     // Tile index → opaque flag
+    int m_collisionLayer = 0;
     const SpriteSheet* m_spriteSheet = nullptr;            // Non-owning pointer
     
+    // Resolved per tile index, refreshed when the sheet's version changes
+    mutable std::vector<SpriteId> m_tileSprites;           // Tile index → sprite ID
+    mutable std::vector<TileUV> m_tileUVs;                 // Tile index → UVs
+    mutable uint64_t m_sheetVersion = 0;
+    mutable uint64_t m_tileTypeVersion = 0;
+    mutable std::unique_ptr<TileTypeTable> m_tileTable;    // GPU copy of m_tileUVs for the shaders
+    mutable bool m_tileTableDirty = true;
+    
+    // Render cache, rebuilt lazily from const Draw
+    mutable std::vector<Chunk> m_chunks;                   // Per layer, chunk grid (row-major)
+    mutable std::vector<int> m_meshChunks;                 // Chunks currently holding a mesh
+    mutable uint64_t m_drawFrame = 0;                      // Incremented by every Draw
+    
+    // IndexTexture mode: GPU copy of the grid, updated from Draw
+    TilemapRenderMode m_renderMode = TilemapRenderMode::Chunks;
+    mutable std::unique_ptr<TileIndexRenderer> m_indexRenderer;
+    mutable std::vector<size_t> m_pendingTexels;           // Layer cells set since the last upload
+    mutable bool m_indexTilesDirty = true;                 // Whole grid must be uploaded
+    
+    // Overviews, one atlas slot per visible chunk, updated from Draw when zoomed out
+    float m_lodZoom = 0.25f;
+    int m_lodResolution = 1;
+    mutable std::vector<std::unique_ptr<Texture2D>> m_lodPages;  // Atlas pages holding the slots
+    mutable std::vector<int> m_lodFreeSlots;               // Slot = page * slots per page + index in page
+    mutable std::vector<int> m_lodChunks;                  // Chunks currently holding a slot
+    mutable std::vector<uint8_t> m_lodTileTexels;          // Tile index → resolution² RGBA texels, rows bottom-up
+    mutable uint64_t m_lodTileTypeVersion = UINT64_MAX;    // m_tileTypeVersion the texels were built for
+    mutable bool m_lodUnavailable = false;                 // Sheet had no CPU pixels at that version
+    mutable std::vector<uint8_t> m_lodPixels;              // One slot's mip chain, upload staging
+    
+    // Collision cache, rebuilt lazily per chunk from const queries
+    mutable std::vector<ColliderChunk> m_colliderChunks;   // Chunk grid (row-major)
+    mutable std::vector<AABB> m_collisionScratch;          // Box list reused by MoveAndSlide
+    
+    void InitLayerTiles(Layer& layer) const;
+    void MarkAllCollidersDirty();
+    const std::vector<TileRect>& GetChunkColliderRects(int chunkX, int chunkY) const;
+    void BuildChunkColliders(int chunkX, int chunkY) const;
+    AABB TileRectToAABB(int chunkX, int chunkY, const TileRect& rect, const Vec2& offset) const;
+    void MarkAllChunksDirty() const;
+    void EnsureTileType(int32_t tileIndex);
+    void ResolveTile(size_t tileIndex) const;
+    void SyncWithSheet() const;
+    void BuildChunk(Renderer2D& renderer, int layer, int chunkX, int chunkY) const;
+    void ReleaseStaleChunks() const;
+    void GetVisibleChunks(const Vec4& view, const Vec2& layerOffset,
+                          int& minX, int& minY, int& maxX, int& maxY) const;
+    bool DrawIndexTexture(Renderer2D& renderer, const Texture2D& texture, const TileTypeTable& tileTypes,
+                          const std::vector<int>& order, const std::vector<Vec2>& offsets) const;
+    bool DrawLod(Renderer2D& renderer, const std::vector<int>& order, const std::vector<Vec2>& offsets) const;
+    void BuildLodTileTexels(const TextureData& pixels) const;
+    int AllocateLodSlot() const;
+    void EncodeLodSlot(int layer, int chunkX, int chunkY, int slot) const;
+    void ReleaseLodSlots() const;
+    
     // Convert 2D coords to 1D index
     int Index(int x, int y) const { return y * m_width + x; }
+    int ChunkIndex(int layer, int chunkX, int chunkY) const {
+        return (layer * m_chunksY + chunkY) * m_chunksX + chunkX;
+    }
     bool InBounds(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+    bool ValidLayer(int layer) const { return layer >= 0 && layer < static_cast<int>(m_layers.size()); }
 };
 
 } // namespace engine
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "engine/math/Vec2.h"
+#include <cstddef>
+#include <vector>
 
 namespace engine {
 
@@ -72,9 +74,34 @@ struct CollisionInfo {
     CollisionInfo() : hit(false), normal(0, 0), penetration(0) {}
 };
 
+// First contact of a box moving against a static box
+struct SweepHit {
+    bool hit;           // Whether contact happens during the move
+    float time;         // Fraction of the move at first contact [0, 1]
+    Vec2 normal;        // Obstacle surface normal at contact
+
+    SweepHit() : hit(false), time(1.0f), normal(0, 0) {}
+};
+
+// Outcome of Collision::MoveAndSlide
+struct MoveResult {
+    Vec2 delta;         // Movement actually applied
+    Vec2 normal;        // Normal per blocked axis (e.g. normal.y > 0 = landed on ground)
+    bool hitX;          // Horizontal movement was blocked
+    bool hitY;          // Vertical movement was blocked
+
+    MoveResult() : delta(0, 0), normal(0, 0), hitX(false), hitY(false) {}
+};
+
 // Collision query and resolution functions
 namespace Collision {
 
+    // Contact tolerance for sweeps. Boxes closer than this on an axis they
+    // do not move along count as touching, not overlapping, which stops
+    // snagging on seams between tiles; a move that starts this deep in
+    // contact is still allowed.
+    constexpr float SWEEP_SKIN = 1e-3f;
+
     // Point tests
     inline bool PointInAABB(const Vec2& point, const AABB& box) {
         return box.Contains(point);
@@ -133,6 +160,123 @@ namespace Collision {
         return info.normal * info.penetration;
     }
 
+    // Bounds covering a box over the whole move (use it to gather obstacles)
+    inline AABB GetSweptBounds(const AABB& box, const Vec2& delta) {
+        AABB bounds = box;
+        bounds.Encapsulate(box.Translated(delta));
+        return bounds;
+    }
+
+    // Swept AABB test: time of impact from per-axis entry/exit times
+    // Boxes that already overlap (deeper than SWEEP_SKIN) are not reported,
+    // separate them with GetSeparation first
+    inline SweepHit SweepAABB(const AABB& moving, const Vec2& delta, const AABB& obstacle) {
+        SweepHit result;
+
+        // Distance to first and last contact per axis, in the direction of motion
+        float entryDistX = delta.x > 0.0f ? obstacle.min.x - moving.max.x : obstacle.max.x - moving.min.x;
+        float exitDistX  = delta.x > 0.0f ? obstacle.max.x - moving.min.x : obstacle.min.x - moving.max.x;
+        float entryDistY = delta.y > 0.0f ? obstacle.min.y - moving.max.y : obstacle.max.y - moving.min.y;
+        float exitDistY  = delta.y > 0.0f ? obstacle.max.y - moving.min.y : obstacle.min.y - moving.max.y;
+
+        // An axis without motion must already overlap, or there is no contact at all
+        float entryX, exitX, entryY, exitY;
+        if (delta.x == 0.0f) {
+            if (moving.max.x <= obstacle.min.x + SWEEP_SKIN || moving.min.x >= obstacle.max.x - SWEEP_SKIN) {
+                return result;
+            }
+            entryX = -1e30f;
+            exitX = 1e30f;
+        } else {
+            entryX = entryDistX / delta.x;
+            exitX = exitDistX / delta.x;
+        }
+        if (delta.y == 0.0f) {
+            if (moving.max.y <= obstacle.min.y + SWEEP_SKIN || moving.min.y >= obstacle.max.y - SWEEP_SKIN) {
+                return result;
+            }
+            entryY = -1e30f;
+            exitY = 1e30f;
+        } else {
+            entryY = entryDistY / delta.y;
+            exitY = exitDistY / delta.y;
+        }
+
+        // Contact starts when the later axis enters and ends when the earlier one exits
+        bool enterOnX = entryX > entryY;
+        float entry = enterOnX ? entryX : entryY;
+        float exit = exitX < exitY ? exitX : exitY;
+        if (entry > exit || entry > 1.0f || exit <= 0.0f) {
+            return result;
+        }
+        if (entry < 0.0f) {
+            // Starting in contact is fine (resting on the ground), starting inside is not
+            float entryDist = enterOnX ? entryDistX : entryDistY;
+            if (entryDist < -SWEEP_SKIN) {
+                return result;
+            }
+            entry = 0.0f;
+        }
+
+        result.hit = true;
+        result.time = entry;
+        if (enterOnX) {
+            result.normal = Vec2(delta.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+        } else {
+            result.normal = Vec2(0.0f, delta.y > 0.0f ? -1.0f : 1.0f);
+        }
+        return result;
+    }
+
+    // Earliest hit of a move against a set of obstacles
+    inline SweepHit SweepAABB(const AABB& moving, const Vec2& delta, const AABB* obstacles, size_t count) {
+        SweepHit first;
+        for (size_t i = 0; i < count; ++i) {
+            SweepHit hit = SweepAABB(moving, delta, obstacles[i]);
+            if (hit.hit && (!first.hit || hit.time < first.time)) {
+                first = hit;
+            }
+        }
+        return first;
+    }
+
+    // Move a box by delta, stopping at the first obstacle on each axis and
+    // sliding along it. X is resolved before Y, each with its own time of
+    // impact, so walking over a row of tiles never catches on their seams.
+    // box.Translated(result.delta) is the new box.
+    inline MoveResult MoveAndSlide(const AABB& box, const Vec2& delta, const AABB* obstacles, size_t count) {
+        MoveResult result;
+        AABB current = box;
+
+        if (delta.x != 0.0f) {
+            Vec2 move(delta.x, 0.0f);
+            SweepHit hit = SweepAABB(current, move, obstacles, count);
+            if (hit.hit) {
+                move.x *= hit.time;
+                result.hitX = true;
+                result.normal.x = hit.normal.x;
+            }
+            current = current.Translated(move);
+            result.delta.x = move.x;
+        }
+
+        if (delta.y != 0.0f) {
+            Vec2 move(0.0f, delta.y);
+            SweepHit hit = SweepAABB(current, move, obstacles, count);
+            if (hit.hit) {
+                move.y *= hit.time;
+                result.hitY = true;
+                result.normal.y = hit.normal.y;
+            }
+            result.delta.y = move.y;
+        }
+        return result;
+    }
+
+    inline MoveResult MoveAndSlide(const AABB& box, const Vec2& delta, const std::vector<AABB>& obstacles) {
+        return MoveAndSlide(box, delta, obstacles.data(), obstacles.size());
+    }
+
 } // namespace Collision
 
 } // namespace engine
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine {
+
+/**
+ * Memory-mapped file (mmap / MapViewOfFile)
+ * Pages are loaded lazily by the OS, so large assets can be read
+ * without an intermediate copy into a heap buffer.
+ * Read-only by default; OpenWritable maps a shared, writable view whose
+ * changes the OS writes back to the file.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Moveable
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map a file (closes any previous mapping). Returns true on success.
+    bool Open(const std::string& path);
+
+    // Map a file for reading and writing, creating it and growing it to at
+    // least minSize bytes (new bytes are zero). Returns true on success.
+    bool OpenWritable(const std::string& path, size_t minSize);
+    void Close();
+
+    // Write modified pages to disk now (writable mappings only)
+    bool Flush();
+
+    const uint8_t* GetData() const { return m_data; }
+    uint8_t* GetWritableData() { return m_writable ? const_cast<uint8_t*>(m_data) : nullptr; }
+    size_t GetSize() const { return m_size; }
+    bool IsOpen() const { return m_data != nullptr; }
+    bool IsWritable() const { return m_writable; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_writable = false;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;     // HANDLE
+    void* m_mappingHandle = nullptr;  // HANDLE
+#endif
+};
+
+} // namespace engine
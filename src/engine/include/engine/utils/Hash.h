@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace engine {
+
+/**
+ * 64-bit FNV-1a string hash.
+ * constexpr, so keys for literal paths/names can be computed at compile time:
+ *   constexpr uint64_t key = HashString("textures/player.png");
+ */
+constexpr uint64_t FNV1A_64_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV1A_64_PRIME = 1099511628211ull;
+
+constexpr uint64_t HashString(std::string_view text, uint64_t seed = FNV1A_64_OFFSET) {
+    uint64_t hash = seed;
+    for (char c : text) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * splitmix64 finalizer: spreads every input bit over the whole result.
+ * Use it to turn structured keys (packed coordinates, counters) into
+ * well-distributed hashes.
+ */
+constexpr uint64_t MixHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace engine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "engine/utils/Hash.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Name -> dense index table backed by a minimal perfect hash (CHD:
+ * "compress, hash and displace").
+ *
+ * Names get indices 0, 1, 2, ... in the order they are added. Build() then
+ * assigns every name its own slot, so a lookup is one bucket read, one slot
+ * read and one 64-bit compare - no probing and no allocations.
+ * Names added after the last Build() are found by a short linear scan until the
+ * table is rebuilt (this happens automatically as the set grows).
+ *
+ * Names are identified by their 64-bit FNV-1a hash, so names written in code can
+ * be hashed at compile time:
+ *   constexpr uint64_t IDLE = HashString("player_idle");
+ *   uint32_t index = table.Find(IDLE);
+ *
+ * Usage:
+ *   NameTable table;
+ *   table.Add("grass");   // 0
+ *   table.Add("water");   // 1
+ *   table.Build();
+ *   table.Find("water");  // 1
+ */
+class NameTable {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    // Add a name and return its index (the existing index if already present)
+    uint32_t Add(std::string_view name);
+
+    // Build the perfect hash over all names added so far
+    // Returns false (lookups keep working, linearly) if no displacement was found.
+    bool Build();
+
+    // Index of a name, or NOT_FOUND
+    uint32_t Find(std::string_view name) const { return Find(HashString(name)); }
+    uint32_t Find(uint64_t nameHash) const;
+
+    // Name stored at an index (empty if out of range)
+    const std::string& GetName(uint32_t index) const;
+
+    size_t Size() const { return m_names.size(); }
+    bool IsEmpty() const { return m_names.empty(); }
+
+    // True when every name is covered by the perfect hash
+    bool IsBuilt() const { return m_builtCount == m_names.size(); }
+
+    void Clear();
+
+private:
+    std::vector<std::string> m_names;   // Index -> name
+    std::vector<uint64_t> m_hashes;     // Index -> 64-bit name hash
+    std::vector<uint32_t> m_seeds;      // Bucket -> displacement seed
+    std::vector<uint32_t> m_slots;      // Slot -> index
+    size_t m_builtCount = 0;            // Names [0, m_builtCount) are in the perfect hash
+
+    uint32_t FindBuilt(uint64_t nameHash) const;
+    uint32_t FindPending(uint64_t nameHash) const;
+};
+
+} // namespace engine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+
+enum class NoiseType {
+    Value,      // Blocky, cheapest: smoothed random values on the integer grid
+    Simplex     // Smooth and isotropic: hashed gradients on a triangle grid
+};
+
+// Fractal (fBm) noise: octaves of one noise type at rising frequency
+struct NoiseSettings {
+    NoiseType type = NoiseType::Simplex;
+    uint32_t seed = 0;
+    float frequency = 1.0f / 32.0f;     // Of the first octave, per unit (tile)
+    int octaves = 1;
+    float lacunarity = 2.0f;            // Frequency multiplier per octave
+    float gain = 0.5f;                  // Amplitude multiplier per octave
+};
+
+/**
+ * Deterministic 2D noise for procedural generation.
+ *
+ * Results depend only on the position, settings and seed: there is no
+ * global state and no permutation table, so the functions are safe to call
+ * from any number of threads, and a region generated in pieces matches the
+ * region generated at once.
+ *
+ * FillNoise is the bulk path. It evaluates rows in blocks of NOISE_LANES
+ * samples with branch-free arithmetic (corners are hashed, gradients come
+ * from hash bits instead of table lookups), so the compiler turns the inner
+ * loops into SIMD code. SampleNoise runs the same code on one sample and
+ * returns the same values (up to rounding where the compiler contracts
+ * multiply-adds).
+ *
+ * Usage:
+ *   NoiseSettings terrain;
+ *   terrain.seed = 1234;
+ *   terrain.octaves = 4;
+ *   float height[32 * 32];
+ *   FillNoise(terrain, originX, originY, 32, 32, height);
+ */
+constexpr int NOISE_LANES = 8;
+
+// Single octave at (x, y), roughly in [-1, 1]
+float ValueNoise(float x, float y, uint32_t seed);
+float SimplexNoise(float x, float y, uint32_t seed);
+
+// Fractal noise at (x, y), normalized to roughly [-1, 1]
+float SampleNoise(const NoiseSettings& settings, float x, float y);
+
+/**
+ * Fractal noise for a width x height block of unit-spaced samples starting
+ * at (x, y), written row-major to out.
+ */
+void FillNoise(const NoiseSettings& settings, float x, float y, int width, int height, float* out);
+
+} // namespace engine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "engine/utils/Hash.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+
+// Chunk coordinates packed into one 64-bit key (both may be negative)
+constexpr uint64_t ChunkKey(int chunkX, int chunkY) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) |
+           static_cast<uint32_t>(chunkY);
+}
+
+constexpr int ChunkKeyX(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key >> 32)); }
+constexpr int ChunkKeyY(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key)); }
+
+// Hasher for ChunkKey maps: neighbouring chunks differ in only a few low bits,
+// so the key is mixed before it picks a bucket
+struct ChunkKeyHash {
+    size_t operator()(uint64_t key) const { return static_cast<size_t>(MixHash(key)); }
+};
+
+// Floor division, so tile -1 lands in chunk -1 rather than chunk 0
+constexpr int FloorDiv(int value, int divisor) {
+    int quotient = value / divisor;
+    return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+} // namespace engine
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "engine/gfx/PackedTileChunk.h"
+#include "engine/utils/Hash.h"
+#include "engine/world/ChunkCoord.h"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace engine {
+
+class ThreadPool;
+class Tilemap;
+
+// What a generation pass sees of the chunk it works on
+struct ChunkGenContext {
+    int chunkX = 0;
+    int chunkY = 0;
+    int originX = 0;                // World tile of cell (0, 0)
+    int originY = 0;
+    uint64_t seed = 0;              // ChunkGenerator::ChunkSeed of this chunk
+    int32_t* tiles = nullptr;       // CHUNK_TILES row-major, EMPTY_TILE before the first pass
+    float* field = nullptr;         // CHUNK_TILES scratch values (noise, heights), kept between passes
+    uint64_t randomState = 0;       // Starts at seed
+
+    // Next value of the chunk's own random stream (splitmix64)
+    uint64_t NextRandom() {
+        randomState += 0x9E3779B97F4A7C15ull;
+        return MixHash(randomState);
+    }
+
+    // Uniform in [0, 1)
+    float NextFloat() { return static_cast<float>(NextRandom() >> 40) * (1.0f / 16777216.0f); }
+};
+
+/**
+ * Procedural tile generation on worker threads, one job per chunk.
+ *
+ * A generator is a list of passes (noise, rules, decoration) that run in
+ * order over one chunk at a time. Each chunk gets its own seed, derived from
+ * the world seed and its coordinate, and passes sample noise (see Noise.h)
+ * in world tile coordinates. A chunk therefore comes out the same whichever
+ * worker builds it and in whatever order, and chunks share nothing while
+ * they are built: throughput grows with the number of workers.
+ *
+ * Workers pack finished chunks (PackedTileChunk) and leave them in a queue.
+ * Publish, called on the main thread, swaps them into the map
+ * (Tilemap::SwapChunk), an O(1) exchange per chunk. No chunk is ever seen
+ * half-built and the main thread never waits on a worker.
+ *
+ * Passes are called from several workers at once; they must only write
+ * through the context they are given.
+ *
+ * The same passes can fill a TileWorld (on its streaming thread):
+ *   world.SetGenerator([&gen](int cx, int cy, int32_t* tiles) { gen.GenerateChunk(cx, cy, tiles); });
+ *
+ * Usage:
+ *   ChunkGenerator gen(worldSeed);
+ *   gen.AddPass([&](ChunkGenContext& ctx) {
+ *       FillNoise(terrain, ctx.originX, ctx.originY, ChunkGenerator::CHUNK_SIZE,
+ *                 ChunkGenerator::CHUNK_SIZE, ctx.field);
+ *       for (int i = 0; i < ChunkGenerator::CHUNK_TILES; ++i) {
+ *           ctx.tiles[i] = ctx.field[i] > 0.3f ? ROCK : GRASS;
+ *       }
+ *   });
+ *   gen.Generate(map);          // Queue every chunk of layer 0
+ *
+ *   // Every frame
+ *   gen.Publish(map);
+ */
+class ChunkGenerator {
+public:
+    static constexpr int CHUNK_SIZE = PackedTileChunk::SIZE;
+    static constexpr int CHUNK_TILES = PackedTileChunk::CELLS;
+
+    using Pass = std::function<void(ChunkGenContext& context)>;
+
+    explicit ChunkGenerator(uint64_t seed = 0);
+
+    // Drops queued chunks; jobs already running finish on their own
+    ~ChunkGenerator();
+
+    // Non-copyable
+    ChunkGenerator(const ChunkGenerator&) = delete;
+    ChunkGenerator& operator=(const ChunkGenerator&) = delete;
+
+    // Passes run in the order added; chunks queued earlier keep the passes they were queued with
+    void AddPass(Pass pass);
+    void ClearPasses();
+
+    uint64_t GetSeed() const { return m_seed; }
+
+    // Worker pool (a private pool is created if none is set)
+    // The pool must outlive the generator. Set before first use.
+    void SetThreadPool(ThreadPool* pool) { m_threadPool = pool; }
+
+    // Queue every chunk of a layer of map, nearest to (focusChunkX, focusChunkY) first
+    void Generate(const Tilemap& map, int layer = 0, int focusChunkX = 0, int focusChunkY = 0);
+
+    // Queue one chunk of a layer of map
+    void QueueChunk(const Tilemap& map, int layer, int chunkX, int chunkY);
+
+    /**
+     * Swap finished chunks into map (main thread, once per frame). Chunks
+     * outside map or for a layer it lacks are dropped.
+     * @param maxChunks Publish at most this many (spreads mesh rebuilds over frames)
+     * @return Number of chunks published
+     */
+    int Publish(Tilemap& map, int maxChunks = INT_MAX);
+
+    // Forget queued and finished chunks (e.g. the level changed)
+    void Cancel();
+
+    // Block until every queued chunk is built (loading screens); Publish still adopts them
+    void Wait();
+
+    // Chunks queued, being built or waiting for Publish
+    size_t GetPendingCount() const;
+
+    // Run all passes for one chunk on the calling thread (any thread)
+    void GenerateChunk(int chunkX, int chunkY, int32_t* tiles) const;
+
+    // Seed of a chunk: every coordinate gets an unrelated stream
+    static uint64_t ChunkSeed(uint64_t worldSeed, int chunkX, int chunkY) {
+        return MixHash(worldSeed ^ MixHash(ChunkKey(chunkX, chunkY)));
+    }
+
+private:
+    struct ResultQueue;  // Shared with worker jobs, outlives the generator if needed
+    using PassList = std::vector<Pass>;
+
+    uint64_t m_seed;
+    std::shared_ptr<const PassList> m_passes;
+    std::shared_ptr<ResultQueue> m_results;
+    ThreadPool* m_threadPool = nullptr;
+    std::unique_ptr<ThreadPool> m_ownedPool;
+
+    ThreadPool& GetThreadPool();
+
+    static void RunPasses(const PassList& passes, uint64_t worldSeed, int chunkX, int chunkY,
+                          int32_t* tiles, float* field);
+};
+
+} // namespace engine
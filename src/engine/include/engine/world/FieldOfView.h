@@ -0,0 +1,118 @@
+#pragma once
+
+#include "engine/math/Vec2.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine {
+
+class Renderer2D;
+class Texture2D;
+class Tilemap;
+
+/**
+ * Field of view over a Tilemap by recursive shadowcasting.
+ *
+ * Cells within the radius of the viewer are visible unless an opaque tile
+ * (Tilemap::SetTileOpaque) hides them; opaque cells that are seen count as
+ * visible themselves. Results live in a bitset the size of the map that is
+ * kept between turns. Update recomputes only when the viewer moved, the
+ * radius changed or OnTileChanged reported an edit to a visible cell (light
+ * never reaches hidden ones, so they can't change what is seen). A recompute
+ * clears just the cells that were visible before, so a turn costs the
+ * visible area, not the map.
+ *
+ * Draw darkens everything outside the view with one textured quad. The
+ * texture has a texel per tile and only the region around the old and new
+ * view is uploaded again. Cells seen earlier keep a lighter shade.
+ *
+ * Usage:
+ *   FieldOfView fov;
+ *   fov.SetViewer(playerX, playerY, 8);
+ *   fov.Update(map);
+ *   map.Draw(renderer);
+ *   fov.Draw(renderer, map);    // After everything it should cover
+ */
+class FieldOfView {
+public:
+    FieldOfView();
+    ~FieldOfView();
+
+    // Non-copyable
+    FieldOfView(const FieldOfView&) = delete;
+    FieldOfView& operator=(const FieldOfView&) = delete;
+
+    // Viewer cell and sight radius in tiles
+    void SetViewer(int x, int y, int radius);
+    int GetViewerX() const { return m_viewerX; }
+    int GetViewerY() const { return m_viewerY; }
+    int GetRadius() const { return m_radius; }
+
+    // Recompute if the view may have changed; true if it was recomputed
+    bool Update(const Tilemap& map);
+
+    // The tile at (x, y) changed opacity
+    void OnTileChanged(int x, int y);
+
+    bool IsVisible(int x, int y) const { return InBounds(x, y) && TestBit(m_visible, y * m_width + x); }
+    bool IsExplored(int x, int y) const { return InBounds(x, y) && TestBit(m_explored, y * m_width + x); }
+
+    // One bit per cell, row-major (bit i of word i / 64)
+    const std::vector<uint64_t>& GetVisibleBits() const { return m_visible; }
+
+    // Row-major indices of the visible cells
+    const std::vector<int>& GetVisibleCells() const { return m_visibleCells; }
+
+    // Forget which cells have been seen before
+    void ClearExplored();
+
+    // Darkness of never-seen and previously-seen cells (0 = none, 1 = black)
+    void SetShade(float unexplored, float explored);
+
+    /**
+     * Cover the map with the visibility texture (call between BeginFrame
+     * and EndFrame, after Update). Draws nothing if the map is larger than
+     * GL_MAX_TEXTURE_SIZE (logged once).
+     * @param offset World position of the tilemap origin (same as Tilemap::Draw)
+     */
+    void Draw(Renderer2D& renderer, const Tilemap& map, const Vec2& offset = Vec2(0.0f, 0.0f));
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_viewerX = 0;
+    int m_viewerY = 0;
+    int m_radius = 0;
+    bool m_dirty = true;
+
+    std::vector<uint64_t> m_visible;
+    std::vector<uint64_t> m_explored;
+    std::vector<int> m_visibleCells;
+
+    // Tiles whose texels are stale (inclusive, empty when minX > maxX)
+    int m_staleMinX = 0;
+    int m_staleMinY = 0;
+    int m_staleMaxX = -1;
+    int m_staleMaxY = -1;
+
+    uint8_t m_unexploredAlpha = 255;
+    uint8_t m_exploredAlpha = 160;
+    std::unique_ptr<Texture2D> m_texture;
+    bool m_textureTooLarge = false;     // Map exceeds GL_MAX_TEXTURE_SIZE; Draw skips until Resize
+    std::vector<uint8_t> m_pixels;      // Upload staging
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+    static bool TestBit(const std::vector<uint64_t>& bits, int index) {
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void Resize(int width, int height);
+    void MarkVisible(int x, int y);
+    void MarkStale(int minX, int minY, int maxX, int maxY);
+    void MarkViewStale();
+    void CastOctant(const Tilemap& map, int row, float startSlope, float endSlope,
+                    int xx, int xy, int yx, int yy);
+};
+
+} // namespace engine
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/math/Vec2.h"
+#include "engine/world/PathGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace engine {
+
+class Tilemap;
+
+/**
+ * Flow field toward one goal cell of a Tilemap.
+ *
+ * The integration field holds the path cost from every cell to the goal
+ * (Dijkstra outward from the goal), the direction field the best neighbor
+ * to step to. Any number of agents heading for the goal then just read the
+ * direction under them: O(1) per agent per frame.
+ *
+ * After a tile changes solidity, OnTileChanged repairs only the cells whose
+ * route went through it (or can now go through it) instead of rebuilding.
+ *
+ * Usage:
+ *   FlowField field;
+ *   field.Build(map, goal);
+ *   Vec2 dir = field.GetDirection(cellX, cellY);
+ */
+class FlowField {
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+    static constexpr uint8_t NO_DIRECTION = 0xFF;
+
+    // Compute both fields for the goal cell (empty if the goal is solid)
+    void Build(const Tilemap& map, const GridPoint& goal);
+
+    // Repair after the tile at (x, y) of map's collision layer changed solidity
+    void OnTileChanged(const Tilemap& map, int x, int y);
+
+    bool IsValid() const { return !m_cost.empty(); }
+    const GridPoint& GetGoal() const { return m_goal; }
+
+    // Path cost to the goal (PathGrid units), UNREACHABLE for solid or cut-off cells
+    uint32_t GetCost(int x, int y) const;
+
+    // Unit vector toward the next cell; zero at the goal and where unreachable
+    Vec2 GetDirection(int x, int y) const;
+
+    // Next cell on the way to the goal; false at the goal or where unreachable
+    bool GetNextCell(int x, int y, GridPoint& next) const;
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    GridPoint m_goal;
+    std::vector<uint32_t> m_cost;       // Integration field (row-major)
+    std::vector<uint8_t> m_direction;   // Index into PathGrid::NEIGHBOR_DX/DY, or NO_DIRECTION
+
+    // Dijkstra open list entry: (cost, cell)
+    using OpenEntry = std::pair<uint32_t, int>;
+
+    bool InBounds(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+    void Propagate(const Tilemap& map, std::vector<OpenEntry>& open, std::vector<int>& changed);
+    void UpdateDirection(const Tilemap& map, int cell);
+};
+
+/**
+ * Keeps flow fields for the most recently used goals.
+ * Agents sharing a goal share one field; fields for goals that have not
+ * been asked for in a while are dropped once maxFields is exceeded.
+ */
+class FlowFieldCache {
+public:
+    explicit FlowFieldCache(size_t maxFields = 8);
+
+    /**
+     * Field toward goal, built on first use.
+     * The reference stays valid until a later Get evicts it.
+     */
+    const FlowField& Get(const Tilemap& map, const GridPoint& goal);
+
+    // Forward a solidity change to every cached field (incremental repair)
+    void OnTileChanged(const Tilemap& map, int x, int y);
+
+    void Clear() { m_fields.clear(); }
+    size_t GetFieldCount() const { return m_fields.size(); }
+
+private:
+    size_t m_maxFields;
+    std::list<std::unique_ptr<FlowField>> m_fields;     // Most recently used first
+};
+
+} // namespace engine
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "engine/world/ChunkCoord.h"
+#include "engine/world/PathGrid.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+/**
+ * Hierarchical pathfinding (HPA*) over a Tilemap.
+ *
+ * The map is split into clusters (chunks by default). Wherever two
+ * neighbouring clusters share an open stretch of border, its ends (or
+ * middle, for short stretches) become abstract nodes, linked across the
+ * border and - with their real path costs - to the other nodes of the same
+ * cluster. A long path is first found on this small graph, then refined
+ * into cells one cluster at a time, so search cost grows with the number of
+ * clusters crossed rather than the number of cells.
+ *
+ * Paths are near-optimal (they pass through border nodes). Tile edits only
+ * rebuild the edited cluster and its neighbours, on the next FindPath.
+ * Not thread-safe: searches share scratch buffers.
+ *
+ * Usage:
+ *   HierarchicalPathfinder pathfinder(map);
+ *   std::vector<GridPoint> path;
+ *   if (pathfinder.FindPath(start, goal, path)) { ... }
+ *   map.SetTile(x, y, wall);
+ *   pathfinder.OnTileChanged(x, y);
+ */
+class HierarchicalPathfinder {
+public:
+    /**
+     * @param map Map to path over (must outlive the pathfinder)
+     * @param clusterSize Cluster side in tiles
+     */
+    explicit HierarchicalPathfinder(const Tilemap& map, int clusterSize = Tilemap::CHUNK_SIZE);
+
+    // Build the abstract graph from scratch (FindPath does this on first use;
+    // call again after the map is resized)
+    void Build();
+
+    // The tile at (x, y) changed solidity
+    void OnTileChanged(int x, int y);
+
+    /**
+     * Find a path of cells from start to goal (both included).
+     * Returns false if either end is solid or no path exists.
+     */
+    bool FindPath(const GridPoint& start, const GridPoint& goal, std::vector<GridPoint>& path);
+
+    size_t GetNodeCount() const { return m_nodes.size(); }
+    int GetClusterSize() const { return m_clusterSize; }
+
+private:
+    struct Edge {
+        uint64_t target;                // Node key (ChunkKey of its cell)
+        uint32_t cost;
+    };
+
+    struct Node {
+        GridPoint cell;
+        int cluster = 0;
+        std::vector<Edge> edges;        // Same cluster (intra) and across borders (inter)
+    };
+
+    const Tilemap* m_map;               // Non-owning
+    int m_clusterSize;
+    int m_clustersX = 0;
+    int m_clustersY = 0;
+
+    std::unordered_map<uint64_t, Node, ChunkKeyHash> m_nodes;   // Cell key -> node
+    std::vector<std::vector<uint64_t>> m_clusterNodes;          // Cluster -> node keys
+    std::vector<uint8_t> m_clusterDirty;
+    bool m_anyDirty = true;
+
+    // Cluster-local search scratch (clusterSize^2 cells)
+    std::vector<uint8_t> m_localWalkable;
+    std::vector<uint32_t> m_localCost;
+    std::vector<uint8_t> m_localParent;
+    std::vector<int32_t> m_rowScratch;
+    int m_localMinX = 0;
+    int m_localMinY = 0;
+    int m_localWidth = 0;
+    int m_localHeight = 0;
+
+    int ClusterOf(int x, int y) const { return (y / m_clusterSize) * m_clustersX + x / m_clusterSize; }
+    void GetClusterRect(int cluster, int& minX, int& minY, int& maxX, int& maxY) const;
+
+    void RebuildDirtyClusters();
+    void AddBorderTransitions(int clusterX, int clusterY, bool vertical);
+    void AddTransition(const GridPoint& a, const GridPoint& b);
+    Node& FindOrAddNode(const GridPoint& cell);
+    void ConnectClusterNodes(int cluster);
+
+    // Snapshot a cluster's walkable cells for the searches that follow
+    void LoadCluster(int cluster);
+    bool IsLocalWalkable(int x, int y) const;
+
+    // Dijkstra (target == nullptr) or A* inside the loaded cluster, from a cell
+    bool SearchCluster(const GridPoint& from, const GridPoint* target);
+    uint32_t GetLocalCost(const GridPoint& cell) const;
+    void AppendLocalPath(const GridPoint& from, const GridPoint& to, std::vector<GridPoint>& path) const;
+};
+
+} // namespace engine
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "engine/gfx/Tilemap.h"
+#include <cstdint>
+#include <cstdlib>
+
+namespace engine {
+
+// Cell of a Tilemap grid
+struct GridPoint {
+    int x = 0;
+    int y = 0;
+
+    bool operator==(const GridPoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GridPoint& other) const { return !(*this == other); }
+};
+
+/**
+ * Movement rules shared by the pathfinders: 8-connected moves over the
+ * non-solid tiles of a Tilemap's collision layer. Diagonal moves may not
+ * cut past a solid corner, which keeps every move reversible (a field
+ * built outward from a goal is valid for walking toward it).
+ * Costs are integers: 10 per straight step, 14 per diagonal.
+ */
+namespace PathGrid {
+
+    constexpr uint32_t STRAIGHT_COST = 10;
+    constexpr uint32_t DIAGONAL_COST = 14;
+
+    // Straight moves first, then diagonals
+    constexpr int NEIGHBOR_COUNT = 8;
+    constexpr int NEIGHBOR_DX[NEIGHBOR_COUNT] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    constexpr int NEIGHBOR_DY[NEIGHBOR_COUNT] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+    inline bool IsWalkable(const Tilemap& map, int x, int y) {
+        return x >= 0 && x < map.GetWidth() && y >= 0 && y < map.GetHeight() && !map.IsSolidAt(x, y);
+    }
+
+    // Step from a walkable cell by (dx, dy), both in -1..1
+    inline bool CanStep(const Tilemap& map, int x, int y, int dx, int dy) {
+        if (!IsWalkable(map, x + dx, y + dy)) return false;
+        if (dx != 0 && dy != 0) {
+            return IsWalkable(map, x + dx, y) && IsWalkable(map, x, y + dy);
+        }
+        return true;
+    }
+
+    constexpr uint32_t StepCost(int dx, int dy) {
+        return (dx != 0 && dy != 0) ? DIAGONAL_COST : STRAIGHT_COST;
+    }
+
+    // Octile distance, exact on an empty grid (admissible for A*)
+    inline uint32_t Heuristic(int x0, int y0, int x1, int y1) {
+        uint32_t dx = static_cast<uint32_t>(std::abs(x1 - x0));
+        uint32_t dy = static_cast<uint32_t>(std::abs(y1 - y0));
+        uint32_t diagonal = dx < dy ? dx : dy;
+        uint32_t straight = (dx > dy ? dx : dy) - diagonal;
+        return diagonal * DIAGONAL_COST + straight * STRAIGHT_COST;
+    }
+
+} // namespace PathGrid
+
+} // namespace engine
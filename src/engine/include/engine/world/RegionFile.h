@@ -0,0 +1,86 @@
+#pragma once
+
+#include "engine/platform/MappedFile.h"
+#include "engine/world/ChunkCoord.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace engine {
+
+/**
+ * Region file (.bwld): fixed-size chunk records in one memory-mapped file.
+ *
+ * File layout (little-endian):
+ *   RegionHeader
+ *   record 0: RegionRecordHeader, chunkSize * chunkSize int32 tiles (row-major)
+ *   record 1: ...
+ *
+ * Records are appended the first time a chunk is written and overwritten in
+ * place afterwards, so saving a chunk is a memcpy into the mapping. The file
+ * grows by doubling its record capacity. Unused capacity is zero-filled.
+ *
+ * Not thread-safe: TileWorld only uses it from its streaming thread.
+ */
+
+constexpr char BWLD_MAGIC[4] = { 'B', 'W', 'L', 'D' };
+constexpr uint16_t BWLD_VERSION = 1;
+
+struct RegionHeader {
+    char magic[4];          // "BWLD"
+    uint16_t version;       // BWLD_VERSION
+    uint16_t chunkSize;     // Tiles per chunk side
+    uint32_t recordCount;   // Records in use
+    uint32_t reserved;
+};
+static_assert(sizeof(RegionHeader) == 16, "RegionHeader layout must stay stable");
+
+struct RegionRecordHeader {
+    int32_t chunkX;
+    int32_t chunkY;
+};
+static_assert(sizeof(RegionRecordHeader) == 8, "RegionRecordHeader layout must stay stable");
+
+class RegionFile {
+public:
+    explicit RegionFile(int chunkSize);
+    ~RegionFile();
+
+    // Non-copyable
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    // Open or create a region file. Fails without touching the file if it is not a
+    // region file or was written with another version or chunk size.
+    bool Open(const std::string& path);
+
+    // Flush and unmap
+    void Close();
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    // Copy a stored chunk into tiles (chunkSize * chunkSize values)
+    // Returns false if the chunk was never written
+    bool Read(int chunkX, int chunkY, int32_t* tiles) const;
+
+    // Store a chunk, appending a record if it is new
+    bool Write(int chunkX, int chunkY, const int32_t* tiles);
+
+    // Write modified pages to disk now
+    bool Flush();
+
+    size_t GetChunkCount() const { return m_records.size(); }
+
+private:
+    MappedFile m_file;
+    std::string m_path;
+    int m_chunkSize;
+    size_t m_capacity = 0;                                            // Records that fit in the mapping
+    std::unordered_map<uint64_t, uint32_t, ChunkKeyHash> m_records;   // ChunkKey -> record index
+
+    size_t GetRecordSize() const;
+    size_t GetTileBytes() const;
+    bool Grow();
+};
+
+} // namespace engine
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "engine/math/Vec2.h"
+#include "engine/world/ChunkCoord.h"
+#include "engine/world/RegionFile.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace engine {
+
+class Renderer2D;
+class Tilemap;
+class VertexArray;
+class VertexBuffer;
+
+/**
+ * Unbounded, sparse tile world streamed in chunks around a focus point.
+ *
+ * Only chunks near the focus (usually the camera) are resident, in a hash
+ * map keyed by chunk coordinate, so memory use depends on the stream radius
+ * and not on the size of the world. A background thread loads chunks from a
+ * memory-mapped region file (or creates them with the generator, or empty)
+ * and writes modified chunks back when they are evicted or on Flush().
+ * The main thread never waits on the disk.
+ *
+ * Tile coordinates are unbounded and may be negative. Tiles of chunks that
+ * are not resident read as EMPTY_TILE and cannot be set.
+ *
+ * Rendering borrows the tile types (sprite sheet and tile -> sprite mapping)
+ * of a Tilemap, whose own grid can be as small as 1x1.
+ *
+ * Usage:
+ *   TileWorld world(32.0f);
+ *   world.SetGenerator([](int cx, int cy, int32_t* tiles) { ... });
+ *   world.Open("saves/overworld.bwld");
+ *
+ *   // Every frame
+ *   world.Update(camera.GetPosition());
+ *   world.Draw(renderer, tileTypes);
+ */
+class TileWorld {
+public:
+    static constexpr int32_t EMPTY_TILE = -1;
+    static constexpr int CHUNK_SIZE = 32;                       // Tiles per chunk side
+    static constexpr int CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+
+    using ChunkTiles = std::array<int32_t, CHUNK_TILES>;        // Row-major
+
+    // Fills a chunk that is not in the region file; runs on the streaming thread
+    using Generator = std::function<void(int chunkX, int chunkY, int32_t* tiles)>;
+
+    explicit TileWorld(float tileSize);
+
+    // Saves modified chunks and stops the streaming thread
+    ~TileWorld();
+
+    // Non-copyable
+    TileWorld(const TileWorld&) = delete;
+    TileWorld& operator=(const TileWorld&) = delete;
+
+    /**
+     * Use a region file as backing store (created if missing).
+     * Without one, evicted chunks are regenerated and their edits are lost.
+     * Call before the first Update.
+     */
+    bool Open(const std::string& regionPath);
+
+    // Save modified chunks, wait for the streaming thread and drop all chunks
+    void Close();
+
+    // Set before the first Update (the streaming thread reads it)
+    void SetGenerator(Generator generator);
+
+    /**
+     * Chunks within radius (in chunks, square) of the focus are loaded.
+     * Chunks are evicted once they are more than radius + 1 away, so walking
+     * along a chunk border does not load and evict the same row repeatedly.
+     */
+    void SetStreamRadius(int radius);
+    int GetStreamRadius() const { return m_streamRadius; }
+
+    /**
+     * Adopt chunks the streaming thread finished, then request and evict
+     * chunks around the focus. Call once per frame on the main thread.
+     * @param focus World position to stream around (e.g. the camera)
+     */
+    void Update(const Vec2& focus);
+
+    // Queue writes of every modified resident chunk and sync the region file
+    void Flush();
+
+    // Block until all queued loads and saves are done (loading screens, shutdown)
+    void WaitForStreaming();
+
+    /**
+     * Tile at world tile coordinates, EMPTY_TILE if its chunk is not resident.
+     */
+    int32_t GetTile(int x, int y) const;
+
+    /**
+     * Set a tile. Returns false if its chunk is not resident.
+     */
+    bool SetTile(int x, int y, int32_t tileIndex);
+
+    // Resident chunk data (nullptr if not loaded)
+    bool IsChunkLoaded(int chunkX, int chunkY) const;
+    const int32_t* GetChunkTiles(int chunkX, int chunkY) const;
+
+    size_t GetLoadedChunkCount() const { return m_chunks.size(); }
+    size_t GetPendingLoadCount() const { return m_pendingLoads.size(); }
+
+    /**
+     * Draw resident chunks inside renderer.GetViewBounds(), using the tile
+     * types of tileTypes (which must use the same tile size). Chunk meshes
+     * are built in chunk-local space, so far-away coordinates keep full
+     * float precision.
+     */
+    void Draw(Renderer2D& renderer, const Tilemap& tileTypes) const;
+
+    float GetTileSize() const { return m_tileSize; }
+
+    // World position -> tile coordinates (fractional)
+    Vec2 WorldToGrid(const Vec2& worldPos) const;
+
+private:
+    struct Chunk {
+        std::unique_ptr<ChunkTiles> tiles;
+        bool modified = false;                            // Differs from the stored version
+
+        // Render cache, rebuilt lazily from const Draw
+        mutable std::unique_ptr<VertexArray> mesh;
+        mutable std::unique_ptr<VertexBuffer> vertices;
+        mutable uint32_t indexCount = 0;
+        mutable uint64_t meshTileTypeVersion = 0;
+        mutable bool meshDirty = true;
+    };
+
+    struct StreamJob {
+        enum class Type { Load, Save, Sync };
+        Type type = Type::Load;
+        int chunkX = 0;
+        int chunkY = 0;
+        std::unique_ptr<ChunkTiles> tiles;                // Save: data to write, Load: result
+    };
+
+    float m_tileSize;
+    int m_streamRadius = 3;
+
+    // Main thread state
+    std::unordered_map<uint64_t, Chunk, ChunkKeyHash> m_chunks;      // Resident chunks
+    std::unordered_set<uint64_t, ChunkKeyHash> m_pendingLoads;       // Requested, not yet adopted
+    int m_focusChunkX = 0;
+    int m_focusChunkY = 0;
+    bool m_focusValid = false;                                       // False forces a request pass
+
+    // Streaming thread and its queues (guarded by m_mutex)
+    RegionFile m_region;
+    Generator m_generator;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    std::deque<StreamJob> m_jobs;
+    std::vector<StreamJob> m_loaded;
+    bool m_jobActive = false;
+    bool m_stopping = false;
+
+    void StartStreaming();
+    void StopStreaming();
+    void StreamLoop();
+    void RunJob(StreamJob& job);
+    void QueueJobs(std::vector<StreamJob>& jobs);
+
+    void AdoptLoadedChunks();
+    void RequestAndEvictChunks();
+    bool InKeepRange(int chunkX, int chunkY) const;
+    void BuildChunkMesh(Renderer2D& renderer, const Tilemap& tileTypes, const Chunk& chunk,
+                        int chunkX, int chunkY) const;
+
+    Chunk* FindChunk(int chunkX, int chunkY);
+    const Chunk* FindChunk(int chunkX, int chunkY) const;
+};
+
+} // namespace engine
@@ -0,0 +1,124 @@
+#include "engine/core/DynamicResolution.h"
+#include "engine/math/MathUtils.h"
+#include <SDL3/SDL_log.h>
+
+namespace engine {
+
+DynamicResolution::DynamicResolution(const DynamicResolutionSettings& settings) {
+    SetSettings(settings);
+    m_scale = m_settings.maxScale;
+}
+
+void DynamicResolution::SetSettings(const DynamicResolutionSettings& settings) {
+    m_settings = settings;
+    if (m_settings.sampleWindow < 1) m_settings.sampleWindow = 1;
+    if (m_settings.minScale > m_settings.maxScale) m_settings.minScale = m_settings.maxScale;
+
+    m_cpuSamples.assign(m_settings.sampleWindow, 0.0f);
+    m_gpuSamples.assign(m_settings.sampleWindow, 0.0f);
+    ClearSamples();
+
+    m_scale = Clamp(m_scale, m_settings.minScale, m_settings.maxScale);
+}
+
+void DynamicResolution::Reset() {
+    m_scale = m_settings.maxScale;
+    m_cooldown = 0;
+    m_log.clear();
+    ClearSamples();
+}
+
+void DynamicResolution::ClearSamples() {
+    m_sampleIndex = 0;
+    m_sampleCount = 0;
+}
+
+// Decide on a new scale once a full window of samples is available
+// Frame cost is treated as proportional to pixel count (scale squared)
+bool DynamicResolution::AddFrameSample(float cpuTimeMs, float gpuTimeMs) {
+    m_frame++;
+
+    m_cpuSamples[m_sampleIndex] = cpuTimeMs;
+    m_gpuSamples[m_sampleIndex] = gpuTimeMs > 0.0f ? gpuTimeMs : 0.0f;
+    m_sampleIndex = (m_sampleIndex + 1) % m_cpuSamples.size();
+    if (m_sampleCount < m_cpuSamples.size()) m_sampleCount++;
+
+    // Hold still after a change so the new scale gets measured fairly
+    if (m_cooldown > 0) {
+        m_cooldown--;
+        return false;
+    }
+    if (m_sampleCount < m_cpuSamples.size()) return false;
+
+    float cpuAvg = 0.0f;
+    float gpuAvg = 0.0f;
+    for (size_t i = 0; i < m_sampleCount; ++i) {
+        cpuAvg += m_cpuSamples[i];
+        gpuAvg += m_gpuSamples[i];
+    }
+    cpuAvg /= m_sampleCount;
+    gpuAvg /= m_sampleCount;
+
+    // Resolution mostly moves GPU cost; fall back to CPU time when GPU timing is unknown
+    // (software rasterizers do their pixel work on the CPU anyway)
+    bool hasGpuTime = gpuAvg > 0.0f;
+    float pixelCost = hasGpuTime ? gpuAvg : cpuAvg;
+    float frameMs = Max(cpuAvg, gpuAvg);
+
+    float budget = m_settings.targetFrameMs;
+    float downLimit = budget * m_settings.downscaleThreshold;
+    float upLimit = budget * m_settings.upscaleThreshold;
+
+    if (frameMs > downLimit) {
+        // CPU-bound: dropping pixels would only blur the image
+        if (hasGpuTime && cpuAvg > gpuAvg) return false;
+        if (m_scale <= m_settings.minScale) return false;
+
+        // Aim for the middle of the dead band in one step
+        float goal = (downLimit + upLimit) * 0.5f;
+        float ideal = m_scale * Sqrt(goal / pixelCost);
+        float newScale = Clamp(Min(ideal, m_scale - m_settings.scaleStep),
+                               m_settings.minScale, m_settings.maxScale);
+        ChangeScale(newScale, cpuAvg, gpuAvg);
+        return true;
+    }
+
+    if (frameMs < upLimit && m_scale < m_settings.maxScale) {
+        float newScale = Min(m_scale + m_settings.scaleStep, m_settings.maxScale);
+
+        // Only step up if the predicted cost stays under the downscale limit,
+        // otherwise the next decision would immediately undo this one
+        float ratio = newScale / m_scale;
+        if (pixelCost * ratio * ratio > downLimit) return false;
+
+        ChangeScale(newScale, cpuAvg, gpuAvg);
+        return true;
+    }
+
+    return false;
+}
+
+void DynamicResolution::ChangeScale(float newScale, float cpuAvg, float gpuAvg) {
+    ResolutionDecision decision;
+    decision.frame = m_frame;
+    decision.fromScale = m_scale;
+    decision.toScale = newScale;
+    decision.cpuTimeMs = cpuAvg;
+    decision.gpuTimeMs = gpuAvg;
+
+    m_log.push_back(decision);
+    if (m_log.size() > MAX_LOG_ENTRIES) {
+        m_log.pop_front();
+    }
+
+    SDL_Log("DynamicResolution: %.2f -> %.2f (cpu %.2fms, gpu %.2fms)",
+            m_scale, newScale, cpuAvg, gpuAvg);
+
+    m_scale = newScale;
+    m_cooldown = m_settings.cooldownFrames;
+
+    // Samples taken at the old scale no longer describe the new one
+    ClearSamples();
+}
+
+} // namespace engine
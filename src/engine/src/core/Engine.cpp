@@ -1,6 +1,8 @@
 #include "engine/core/Engine.h"
+#include "engine/gfx/GLFunctions.h"
 #include <SDL3/SDL_opengl.h>
 #include <SDL3/SDL_timer.h>
+#include <SDL3/SDL_log.h>
 
 namespace engine {
 
@@ -18,6 +20,11 @@ void Engine::Run() {
     // Set initial viewport
     glViewport(0, 0, m_window.GetWidth(), m_window.GetHeight());
     
+    // GPU timing feeds the frame stats and dynamic resolution
+    if (LoadGLFunctions()) {
+        m_gpuTimer.Init();
+    }
+    
     // Frame rate target: 60 FPS = 16.67ms per frame
     const Uint64 targetFrameTimeNS = SDL_NS_PER_SECOND / 60;
     Uint64 lastFrameTime = SDL_GetPerformanceCounter();
@@ -42,18 +49,39 @@ void Engine::Run() {
             HandleResize();
         }
         
+        // Publish background uploads that finished on the GPU
+        if (m_uploadThread) {
+            m_uploadThread->Poll();
+        }
+        
         // Update game logic first (check justPressed before it gets reset)
         Update(deltaTime);
         
         // Update input state: reset justPressed/justReleased flags for next frame
         m_input.Update(deltaTime);
         
-        // Render frame
+        // Render frame (into the scaled target when dynamic resolution is on)
+        m_gpuTimer.Begin();
+        BeginSceneRender();
         Render();
+        EndSceneRender();
+        m_gpuTimer.End();
+        
+        // CPU cost of the frame, measured before the swap can block on vsync
+        Uint64 workNS = ((SDL_GetPerformanceCounter() - currentTime) * SDL_NS_PER_SECOND) / frequency;
         
         // Display rendered frame
         m_glContext.SwapBuffers(m_window.GetWindow());
         
+        // Update stats (GPU results arrive a few frames late)
+        m_gpuTimer.Collect();
+        m_frameStats.frameIndex++;
+        m_frameStats.cpuTimeMs = static_cast<float>(workNS) / 1000000.0f;
+        m_frameStats.gpuTimeMs = m_gpuTimer.GetLastTimeMs();
+        if (m_dynamicResolution) {
+            m_dynamicResolution->AddFrameSample(m_frameStats.cpuTimeMs, m_frameStats.gpuTimeMs);
+        }
+        
         // Frame rate limiting: sleep if frame completed early
         Uint64 elapsedNS = ((SDL_GetPerformanceCounter() - currentTime) * SDL_NS_PER_SECOND) / frequency;
         if (elapsedNS < targetFrameTimeNS) {
@@ -75,6 +103,92 @@ void Engine::HandleResize() {
     }
 }
 
+void Engine::EnableDynamicResolution(const DynamicResolutionSettings& settings) {
+    if (!LoadGLFunctions()) {
+        SDL_Log("Engine: Cannot enable dynamic resolution without OpenGL functions");
+        return;
+    }
+    
+    if (m_dynamicResolution) {
+        m_dynamicResolution->SetSettings(settings);
+    } else {
+        m_dynamicResolution = std::make_unique<DynamicResolution>(settings);
+    }
+    SDL_Log("Engine: Dynamic resolution enabled (scale %.2f - %.2f, target %.2fms)",
+            settings.minScale, settings.maxScale, settings.targetFrameMs);
+}
+
+void Engine::DisableDynamicResolution() {
+    m_dynamicResolution.reset();
+    m_sceneTarget.reset();
+    glViewport(0, 0, m_window.GetWidth(), m_window.GetHeight());
+}
+
+bool Engine::EnableUploadThread() {
+    if (m_uploadThread) return true;
+    
+    if (!LoadGLFunctions()) {
+        SDL_Log("Engine: Cannot start upload thread without OpenGL functions");
+        return false;
+    }
+    
+    auto uploadThread = std::make_unique<GLUploadThread>();
+    if (!uploadThread->Start(m_window.GetWindow(), m_glContext)) {
+        SDL_Log("Engine: Upload thread unavailable, uploads stay on the render thread");
+        return false;
+    }
+    m_uploadThread = std::move(uploadThread);
+    return true;
+}
+
+// Redirect scene rendering into an offscreen target sized by the current scale
+// Camera projection is resolution-independent, so scenes need no changes
+void Engine::BeginSceneRender() {
+    int width = m_window.GetWidth();
+    int height = m_window.GetHeight();
+    
+    if (!m_dynamicResolution) {
+        m_frameStats.renderScale = 1.0f;
+        m_frameStats.renderWidth = width;
+        m_frameStats.renderHeight = height;
+        return;
+    }
+    
+    float scale = m_dynamicResolution->GetScale();
+    int targetWidth = static_cast<int>(width * scale + 0.5f);
+    int targetHeight = static_cast<int>(height * scale + 0.5f);
+    if (targetWidth < 1) targetWidth = 1;
+    if (targetHeight < 1) targetHeight = 1;
+    
+    if (!m_sceneTarget) {
+        m_sceneTarget = std::make_unique<RenderTarget>(targetWidth, targetHeight);
+    } else {
+        m_sceneTarget->Resize(targetWidth, targetHeight);
+    }
+    
+    m_frameStats.renderScale = scale;
+    m_frameStats.renderWidth = targetWidth;
+    m_frameStats.renderHeight = targetHeight;
+    
+    if (m_sceneTarget->IsValid()) {
+        m_sceneTarget->Bind();
+    }
+}
+
+// Upscale the offscreen target to the window and restore the default framebuffer
+void Engine::EndSceneRender() {
+    if (!m_dynamicResolution || !m_sceneTarget || !m_sceneTarget->IsValid()) {
+        return;
+    }
+    
+    int width = m_window.GetWidth();
+    int height = m_window.GetHeight();
+    
+    RenderTarget::Unbind();
+    glViewport(0, 0, width, height);
+    m_sceneTarget->BlitToScreen(width, height);
+}
+
 void Engine::Update(float deltaTime) {
     // Call user-provided update callback if registered
     if (m_updateCallback) {
@@ -1,15 +1,74 @@
 #include "engine/gfx/AnimationController.h"
 #include "engine/utils/JsonParser.h"
 #include <SDL3/SDL_log.h>
+#include <algorithm>
 
 namespace engine {
 
-void AnimationController::AddAnimation(const Animation& animation) {
+void AnimationController::SetSpriteSheet(const SpriteSheet* sheet) {
+    m_spriteSheet = sheet;
+    m_sheetVersion = m_spriteSheet ? m_spriteSheet->GetVersion() : 0;
+    for (auto& animation : m_animations) {
+        ResolveSprites(animation);
+    }
+}
+
+AnimationId AnimationController::AddAnimation(const Animation& animation) {
     if (animation.name.empty()) {
         SDL_Log("AnimationController: Cannot add animation with empty name");
-        return;
+        return INVALID_ANIMATION_ID;
+    }
+
+    uint32_t index = m_animationNames.Add(animation.name);
+    if (index == NameTable::NOT_FOUND) {
+        return INVALID_ANIMATION_ID;
+    }
+
+    AnimationId id = static_cast<AnimationId>(index);
+    if (index < m_animations.size()) {
+        m_animations[id] = animation;
+        if (m_currentAnimation == id) {
+            // Frame count may have changed, restart from the top
+            m_currentFrame = 0;
+            m_frameTimer = 0.0f;
+        }
+    } else {
+        m_animations.push_back(animation);
+    }
+
+    ResolveSprites(m_animations[id]);
+    return id;
+}
+
+AnimationId AnimationController::FindAnimation(const std::string& name) const {
+    return FindAnimation(HashString(name));
+}
+
+AnimationId AnimationController::FindAnimation(uint64_t nameHash) const {
+    uint32_t index = m_animationNames.Find(nameHash);
+    return index != NameTable::NOT_FOUND ? static_cast<AnimationId>(index) : INVALID_ANIMATION_ID;
+}
+
+// Look frame sprites up once, so playback only indexes arrays
+void AnimationController::ResolveSprites(Animation& animation, bool logMissing) const {
+    for (auto& frame : animation.frames) {
+        frame.spriteId = m_spriteSheet ? m_spriteSheet->FindSprite(frame.spriteName) : INVALID_SPRITE_ID;
+        if (logMissing && m_spriteSheet && frame.spriteId == INVALID_SPRITE_ID) {
+            SDL_Log("AnimationController: Sprite '%s' in '%s' not found in sprite sheet",
+                    frame.spriteName.c_str(), animation.name.c_str());
+        }
+    }
+}
+
+// The sheet changed since frames were resolved (reload, sprites added):
+// names may map to other IDs now. Missing sprites were reported already
+void AnimationController::SyncWithSheet() const {
+    if (!m_spriteSheet || m_spriteSheet->GetVersion() == m_sheetVersion) return;
+
+    m_sheetVersion = m_spriteSheet->GetVersion();
+    for (auto& animation : m_animations) {
+        ResolveSprites(animation, false);
     }
-    m_animations[animation.name] = animation;
 }
 
 bool AnimationController::LoadAnimations(const std::string& jsonPath) {
@@ -24,10 +83,20 @@ bool AnimationController::LoadAnimations(const std::string& jsonPath) {
         return false;
     }
 
+    // JSON objects are unordered: sort names so IDs are the same on every load
     const JsonValue& animations = root["animations"];
-    int loadedCount = 0;
-
+    std::vector<std::pair<const std::string*, const JsonValue*>> entries;
     for (const auto& [animName, animValue] : animations) {
+        entries.emplace_back(&animName, &animValue);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return *a.first < *b.first;
+    });
+
+    int loadedCount = 0;
+    for (const auto& [namePtr, valuePtr] : entries) {
+        const std::string& animName = *namePtr;
+        const JsonValue& animValue = *valuePtr;
         if (!animValue.IsObject()) continue;
 
         Animation anim(animName);
@@ -66,23 +135,34 @@ bool AnimationController::LoadAnimations(const std::string& jsonPath) {
         }
 
         if (!anim.IsEmpty()) {
-            m_animations[animName] = anim;
+            AddAnimation(anim);
             ++loadedCount;
         }
     }
 
+    // Name set is final, build the perfect hash for FindAnimation
+    m_animationNames.Build();
+
     SDL_Log("AnimationController: Loaded %d animations from '%s'", loadedCount, jsonPath.c_str());
     return loadedCount > 0;
 }
 
 void AnimationController::Play(const std::string& name) {
-    auto it = m_animations.find(name);
-    if (it == m_animations.end()) {
+    AnimationId id = FindAnimation(name);
+    if (id == INVALID_ANIMATION_ID) {
         SDL_Log("AnimationController: Animation '%s' not found", name.c_str());
         return;
     }
+    Play(id);
+}
+
+void AnimationController::Play(AnimationId id) {
+    if (id < 0 || static_cast<size_t>(id) >= m_animations.size()) {
+        SDL_Log("AnimationController: Animation ID %d not found", id);
+        return;
+    }
 
-    m_currentAnimation = name;
+    m_currentAnimation = id;
     m_currentFrame = 0;
     m_frameTimer = 0.0f;
     m_playing = true;
@@ -91,8 +171,17 @@ void AnimationController::Play(const std::string& name) {
 }
 
 void AnimationController::PlayIfNot(const std::string& name) {
-    if (m_currentAnimation != name || m_finished) {
-        Play(name);
+    AnimationId id = FindAnimation(name);
+    if (id == INVALID_ANIMATION_ID) {
+        SDL_Log("AnimationController: Animation '%s' not found", name.c_str());
+        return;
+    }
+    PlayIfNot(id);
+}
+
+void AnimationController::PlayIfNot(AnimationId id) {
+    if (m_currentAnimation != id || m_finished) {
+        Play(id);
     }
 }
 
@@ -146,14 +235,16 @@ const Sprite* AnimationController::GetCurrentSprite() const {
     if (!m_spriteSheet) {
         return nullptr;
     }
+    return m_spriteSheet->GetSprite(GetCurrentSpriteId());
+}
 
+SpriteId AnimationController::GetCurrentSpriteId() const {
+    SyncWithSheet();
     const Animation* anim = GetCurrentAnimation();
     if (!anim || anim->IsEmpty()) {
-        return nullptr;
+        return INVALID_SPRITE_ID;
     }
-
-    const std::string& spriteName = anim->frames[m_currentFrame].spriteName;
-    return m_spriteSheet->GetSprite(spriteName);
+    return anim->frames[m_currentFrame].spriteId;
 }
 
 const std::string& AnimationController::GetCurrentSpriteName() const {
@@ -167,13 +258,17 @@ const std::string& AnimationController::GetCurrentSpriteName() const {
     return anim->frames[m_currentFrame].spriteName;
 }
 
+const std::string& AnimationController::GetCurrentAnimationName() const {
+    static const std::string empty;
+    const Animation* anim = GetCurrentAnimation();
+    return anim ? anim->name : empty;
+}
+
 const Animation* AnimationController::GetCurrentAnimation() const {
-    if (m_currentAnimation.empty()) {
+    if (m_currentAnimation < 0 || static_cast<size_t>(m_currentAnimation) >= m_animations.size()) {
         return nullptr;
     }
-    
-    auto it = m_animations.find(m_currentAnimation);
-    return it != m_animations.end() ? &it->second : nullptr;
+    return &m_animations[m_currentAnimation];
 }
 
 void AnimationController::AdvanceFrame() {
@@ -0,0 +1,186 @@
+#include "engine/gfx/CookedTexture.h"
+#include "engine/gfx/Texture2D.h"
+#include <SDL3/SDL_log.h>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace engine {
+
+namespace CookedTexture {
+
+size_t GetLevelSize(BtexFormat format, int width, int height) {
+    switch (format) {
+        case BtexFormat::RGBA8:
+            return static_cast<size_t>(width) * height * 4;
+    }
+    return 0;
+}
+
+// Check header fields, that the level count fits the image and that every
+// level fits in the buffer
+bool Parse(const uint8_t* data, size_t size, CookedTextureView& outView) {
+    outView = CookedTextureView();
+
+    if (!data || size < sizeof(BtexHeader)) {
+        return false;
+    }
+
+    const BtexHeader* header = reinterpret_cast<const BtexHeader*>(data);
+    if (std::memcmp(header->magic, BTEX_MAGIC, sizeof(BTEX_MAGIC)) != 0) {
+        SDL_Log("CookedTexture: Bad magic");
+        return false;
+    }
+    if (header->version != BTEX_VERSION) {
+        SDL_Log("CookedTexture: Unsupported version %u", header->version);
+        return false;
+    }
+    if (header->format != static_cast<uint16_t>(BtexFormat::RGBA8)) {
+        SDL_Log("CookedTexture: Unsupported format %u", header->format);
+        return false;
+    }
+    // More levels than the full chain would make glTexStorage2D fail
+    constexpr uint32_t maxSize = 1u << (BTEX_MAX_LEVELS - 1);
+    if (header->width == 0 || header->height == 0 || header->width > maxSize ||
+        header->height > maxSize || header->mipLevels == 0 ||
+        header->mipLevels > static_cast<uint32_t>(Texture2D::ComputeMipLevels(
+            static_cast<int>(header->width), static_cast<int>(header->height)))) {
+        SDL_Log("CookedTexture: Invalid dimensions %ux%u (%u levels)",
+                header->width, header->height, header->mipLevels);
+        return false;
+    }
+
+    BtexFormat format = static_cast<BtexFormat>(header->format);
+    const uint8_t* cursor = data + sizeof(BtexHeader);
+    size_t remaining = size - sizeof(BtexHeader);
+
+    int width = static_cast<int>(header->width);
+    int height = static_cast<int>(header->height);
+    for (uint32_t level = 0; level < header->mipLevels; ++level) {
+        size_t levelSize = GetLevelSize(format, width, height);
+        if (levelSize > remaining) {
+            SDL_Log("CookedTexture: Truncated at level %u", level);
+            return false;
+        }
+        outView.levels[level] = cursor;
+        cursor += levelSize;
+        remaining -= levelSize;
+
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    if (header->dataSize != static_cast<uint64_t>(cursor - (data + sizeof(BtexHeader)))) {
+        SDL_Log("CookedTexture: Data size %llu does not match its levels (%zu bytes)",
+                static_cast<unsigned long long>(header->dataSize),
+                static_cast<size_t>(cursor - (data + sizeof(BtexHeader))));
+        return false;
+    }
+
+    outView.header = header;
+    outView.levelCount = static_cast<int>(header->mipLevels);
+    outView.width = static_cast<int>(header->width);
+    outView.height = static_cast<int>(header->height);
+    return true;
+}
+
+// Matches glGenerateMipmap closely; odd edges reuse the last row/column
+void Downsample(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth, int dstHeight) {
+
+    for (int y = 0; y < dstHeight; ++y) {
+        int y0 = y * 2;
+        int y1 = (y0 + 1 < srcHeight) ? y0 + 1 : y0;
+        for (int x = 0; x < dstWidth; ++x) {
+            int x0 = x * 2;
+            int x1 = (x0 + 1 < srcWidth) ? x0 + 1 : x0;
+
+            const uint8_t* p00 = src + (static_cast<size_t>(y0) * srcWidth + x0) * 4;
+            const uint8_t* p10 = src + (static_cast<size_t>(y0) * srcWidth + x1) * 4;
+            const uint8_t* p01 = src + (static_cast<size_t>(y1) * srcWidth + x0) * 4;
+            const uint8_t* p11 = src + (static_cast<size_t>(y1) * srcWidth + x1) * 4;
+            uint8_t* out = dst + (static_cast<size_t>(y) * dstWidth + x) * 4;
+
+            for (int c = 0; c < 4; ++c) {
+                out[c] = static_cast<uint8_t>((p00[c] + p10[c] + p01[c] + p11[c] + 2) / 4);
+            }
+        }
+    }
+}
+
+bool Write(const std::string& path, const uint8_t* pixels, int width, int height,
+           bool generateMips) {
+    if (!pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    // Build the mip chain on the CPU (level 0 is the source itself)
+    std::vector<std::vector<uint8_t>> mips;
+    std::vector<int> widths = { width };
+    std::vector<int> heights = { height };
+    if (generateMips) {
+        const uint8_t* src = pixels;
+        int w = width;
+        int h = height;
+        while ((w > 1 || h > 1) && static_cast<int>(widths.size()) < BTEX_MAX_LEVELS) {
+            int nw = w > 1 ? w / 2 : 1;
+            int nh = h > 1 ? h / 2 : 1;
+            mips.emplace_back(static_cast<size_t>(nw) * nh * 4);
+            Downsample(src, w, h, mips.back().data(), nw, nh);
+            src = mips.back().data();
+            w = nw;
+            h = nh;
+            widths.push_back(w);
+            heights.push_back(h);
+        }
+    }
+
+    BtexHeader header = {};
+    std::memcpy(header.magic, BTEX_MAGIC, sizeof(BTEX_MAGIC));
+    header.version = BTEX_VERSION;
+    header.format = static_cast<uint16_t>(BtexFormat::RGBA8);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.mipLevels = static_cast<uint32_t>(widths.size());
+    for (size_t i = 0; i < widths.size(); ++i) {
+        header.dataSize += GetLevelSize(BtexFormat::RGBA8, widths[i], heights[i]);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        SDL_Log("CookedTexture: Failed to open '%s' for writing", path.c_str());
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(pixels),
+               GetLevelSize(BtexFormat::RGBA8, width, height));
+    for (const auto& level : mips) {
+        file.write(reinterpret_cast<const char*>(level.data()), level.size());
+    }
+
+    if (!file.good()) {
+        SDL_Log("CookedTexture: Failed writing '%s'", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string GetCookedPath(const std::string& sourcePath) {
+    size_t lastSlash = sourcePath.find_last_of("/\\");
+    size_t lastDot = sourcePath.find_last_of('.');
+    if (lastDot == std::string::npos ||
+        (lastSlash != std::string::npos && lastDot < lastSlash)) {
+        return sourcePath + ".btex";
+    }
+    return sourcePath.substr(0, lastDot) + ".btex";
+}
+
+bool IsCookedPath(const std::string& path) {
+    static const std::string ext = ".btex";
+    return path.size() >= ext.size() &&
+           path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+} // namespace CookedTexture
+
+} // namespace engine
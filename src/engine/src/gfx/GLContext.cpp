@@ -28,5 +28,23 @@ void GLContext::SwapBuffers(SDL_Window* window) {
     SDL_GL_SwapWindow(window);
 }
 
+SDL_GLContext GLContext::CreateSharedContext(SDL_Window* window) {
+    if (!m_context) return nullptr;
+
+    // Sharing is with whatever context is current at creation time
+    SDL_GL_MakeCurrent(window, m_context);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    SDL_GLContext shared = SDL_GL_CreateContext(window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+    if (!shared) {
+        SDL_Log("Failed to create shared OpenGL context: %s", SDL_GetError());
+    }
+
+    // Creating a context makes it current, switch back to the main one
+    SDL_GL_MakeCurrent(window, m_context);
+    return shared;
+}
+
 } // namespace engine
 
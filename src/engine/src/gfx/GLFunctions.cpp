@@ -45,9 +45,34 @@ void (APIENTRY *glGenTextures)(GLsizei n, GLuint* textures) = nullptr;
 void (APIENTRY *glDeleteTextures)(GLsizei n, const GLuint* textures) = nullptr;
 void (APIENTRY *glBindTexture)(GLenum target, GLuint texture) = nullptr;
 void (APIENTRY *glTexImage2D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) = nullptr;
+void (APIENTRY *glTexSubImage2D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) = nullptr;
+void (APIENTRY *glTexImage3D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) = nullptr;
+void (APIENTRY *glTexSubImage3D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) = nullptr;
 void (APIENTRY *glTexParameteri)(GLenum target, GLenum pname, GLint param) = nullptr;
 void (APIENTRY *glActiveTexture)(GLenum texture) = nullptr;
 void (APIENTRY *glGenerateMipmap)(GLenum target) = nullptr;
+void (APIENTRY *glTexStorage2D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) = nullptr;
+
+// Framebuffer functions
+void (APIENTRY *glGenFramebuffers)(GLsizei n, GLuint* framebuffers) = nullptr;
+void (APIENTRY *glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers) = nullptr;
+void (APIENTRY *glBindFramebuffer)(GLenum target, GLuint framebuffer) = nullptr;
+void (APIENTRY *glFramebufferTexture2D)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) = nullptr;
+GLenum (APIENTRY *glCheckFramebufferStatus)(GLenum target) = nullptr;
+void (APIENTRY *glBlitFramebuffer)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) = nullptr;
+
+// Query functions (GPU timing)
+void (APIENTRY *glGenQueries)(GLsizei n, GLuint* ids) = nullptr;
+void (APIENTRY *glDeleteQueries)(GLsizei n, const GLuint* ids) = nullptr;
+void (APIENTRY *glBeginQuery)(GLenum target, GLuint id) = nullptr;
+void (APIENTRY *glEndQuery)(GLenum target) = nullptr;
+void (APIENTRY *glGetQueryObjectiv)(GLuint id, GLenum pname, GLint* params) = nullptr;
+void (APIENTRY *glGetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64* params) = nullptr;
+
+// Sync objects (background uploads)
+GLsync (APIENTRY *glFenceSync)(GLenum condition, GLbitfield flags) = nullptr;
+GLenum (APIENTRY *glClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout) = nullptr;
+void (APIENTRY *glDeleteSync)(GLsync sync) = nullptr;
 
 bool LoadGLFunctions() {
     static bool loaded = false;
@@ -94,10 +119,41 @@ bool LoadGLFunctions() {
     glDeleteTextures = (decltype(glDeleteTextures))SDL_GL_GetProcAddress("glDeleteTextures");
     glBindTexture = (decltype(glBindTexture))SDL_GL_GetProcAddress("glBindTexture");
     glTexImage2D = (decltype(glTexImage2D))SDL_GL_GetProcAddress("glTexImage2D");
+    glTexSubImage2D = (decltype(glTexSubImage2D))SDL_GL_GetProcAddress("glTexSubImage2D");
+    glTexImage3D = (decltype(glTexImage3D))SDL_GL_GetProcAddress("glTexImage3D");
+    glTexSubImage3D = (decltype(glTexSubImage3D))SDL_GL_GetProcAddress("glTexSubImage3D");
     glTexParameteri = (decltype(glTexParameteri))SDL_GL_GetProcAddress("glTexParameteri");
     glActiveTexture = (decltype(glActiveTexture))SDL_GL_GetProcAddress("glActiveTexture");
     glGenerateMipmap = (decltype(glGenerateMipmap))SDL_GL_GetProcAddress("glGenerateMipmap");
     
+    // Immutable texture storage is optional on GL 3.3; some platforms hand out
+    // non-null stubs for unsupported entry points, so check the extension too
+    glTexStorage2D = (decltype(glTexStorage2D))SDL_GL_GetProcAddress("glTexStorage2D");
+    if (!SDL_GL_ExtensionSupported("GL_ARB_texture_storage")) {
+        glTexStorage2D = nullptr;
+    }
+    
+    // Framebuffer functions
+    glGenFramebuffers = (decltype(glGenFramebuffers))SDL_GL_GetProcAddress("glGenFramebuffers");
+    glDeleteFramebuffers = (decltype(glDeleteFramebuffers))SDL_GL_GetProcAddress("glDeleteFramebuffers");
+    glBindFramebuffer = (decltype(glBindFramebuffer))SDL_GL_GetProcAddress("glBindFramebuffer");
+    glFramebufferTexture2D = (decltype(glFramebufferTexture2D))SDL_GL_GetProcAddress("glFramebufferTexture2D");
+    glCheckFramebufferStatus = (decltype(glCheckFramebufferStatus))SDL_GL_GetProcAddress("glCheckFramebufferStatus");
+    glBlitFramebuffer = (decltype(glBlitFramebuffer))SDL_GL_GetProcAddress("glBlitFramebuffer");
+    
+    // Query functions (GPU timing)
+    glGenQueries = (decltype(glGenQueries))SDL_GL_GetProcAddress("glGenQueries");
+    glDeleteQueries = (decltype(glDeleteQueries))SDL_GL_GetProcAddress("glDeleteQueries");
+    glBeginQuery = (decltype(glBeginQuery))SDL_GL_GetProcAddress("glBeginQuery");
+    glEndQuery = (decltype(glEndQuery))SDL_GL_GetProcAddress("glEndQuery");
+    glGetQueryObjectiv = (decltype(glGetQueryObjectiv))SDL_GL_GetProcAddress("glGetQueryObjectiv");
+    glGetQueryObjectui64v = (decltype(glGetQueryObjectui64v))SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+    
+    // Sync objects (background uploads)
+    glFenceSync = (decltype(glFenceSync))SDL_GL_GetProcAddress("glFenceSync");
+    glClientWaitSync = (decltype(glClientWaitSync))SDL_GL_GetProcAddress("glClientWaitSync");
+    glDeleteSync = (decltype(glDeleteSync))SDL_GL_GetProcAddress("glDeleteSync");
+    
     // Verify critical functions loaded
     if (!glCreateShader || !glCreateProgram || !glGenVertexArrays || !glGenBuffers || 
         !glGenTextures || !glActiveTexture) {
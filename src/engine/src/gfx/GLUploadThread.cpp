@@ -0,0 +1,176 @@
+#include "engine/gfx/GLUploadThread.h"
+#include "engine/gfx/GLContext.h"
+#include "engine/gfx/GLFunctions.h"
+#include <SDL3/SDL_log.h>
+#include <future>
+
+namespace engine {
+
+// Stop: wait this long per attempt on a fence still in flight
+static constexpr GLuint64 STOP_FENCE_TIMEOUT_NS = 1000000000;
+
+GLUploadThread::~GLUploadThread() {
+    Stop();
+}
+
+bool GLUploadThread::Start(SDL_Window* window, GLContext& context) {
+    if (IsRunning()) return true;
+
+    if (!glFenceSync || !glClientWaitSync || !glDeleteSync) {
+        SDL_Log("GLUploadThread: Sync objects not available");
+        return false;
+    }
+
+    m_sharedContext = context.CreateSharedContext(window);
+    if (!m_sharedContext) {
+        return false;
+    }
+    m_window = window;
+    m_stopping = false;
+
+    // Wait until the thread has made its context current, so failures are reported here
+    std::promise<bool> started;
+    std::future<bool> startedResult = started.get_future();
+    m_thread = std::thread([this, &started]() {
+        if (!SDL_GL_MakeCurrent(m_window, m_sharedContext)) {
+            SDL_Log("GLUploadThread: Failed to make context current: %s", SDL_GetError());
+            started.set_value(false);
+            return;
+        }
+        started.set_value(true);
+        ThreadLoop();
+        SDL_GL_MakeCurrent(m_window, nullptr);
+    });
+
+    if (!startedResult.get()) {
+        m_thread.join();
+        SDL_GL_DestroyContext(m_sharedContext);
+        m_sharedContext = nullptr;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_accepting = true;
+    }
+    SDL_Log("GLUploadThread: Started");
+    return true;
+}
+
+// Every completion still runs, so callers waiting on one can resolve or retry
+void GLUploadThread::Stop() {
+    if (!IsRunning()) return;
+
+    std::deque<QueuedJob> skipped;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_accepting = false;
+        skipped.swap(m_jobs);
+    }
+    m_jobAvailable.notify_all();
+    m_thread.join();
+
+    // Uploads that ran finish normally; sync objects are shared, so the
+    // render thread's context can wait on and delete them
+    std::deque<FencedJob> fenced;
+    fenced.swap(m_fenced);
+    for (auto& job : fenced) {
+        GLenum status;
+        do {
+            status = glClientWaitSync(job.fence, GL_SYNC_FLUSH_COMMANDS_BIT, STOP_FENCE_TIMEOUT_NS);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        if (status == GL_WAIT_FAILED) {
+            SDL_Log("GLUploadThread: glClientWaitSync failed");
+        }
+        glDeleteSync(job.fence);
+        if (job.onComplete) {
+            job.onComplete(true);
+        }
+    }
+
+    for (auto& job : skipped) {
+        if (job.onComplete) {
+            job.onComplete(false);
+        }
+    }
+
+    SDL_GL_DestroyContext(m_sharedContext);
+    m_sharedContext = nullptr;
+}
+
+// Nothing would ever run a job queued before Start() or after Stop()
+void GLUploadThread::Submit(Job upload, Completion onComplete) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_accepting) {
+            m_jobs.push_back({ std::move(upload), std::move(onComplete) });
+            m_jobAvailable.notify_one();
+            return;
+        }
+    }
+    if (onComplete) {
+        onComplete(false);
+    }
+}
+
+size_t GLUploadThread::Poll() {
+    size_t completed = 0;
+    while (true) {
+        FencedJob fenced;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_fenced.empty()) break;
+
+            // Zero timeout: just ask whether the GPU got there yet
+            GLenum status = glClientWaitSync(m_fenced.front().fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) break;
+            if (status == GL_WAIT_FAILED) {
+                SDL_Log("GLUploadThread: glClientWaitSync failed");
+            }
+            fenced = std::move(m_fenced.front());
+            m_fenced.pop_front();
+        }
+
+        glDeleteSync(fenced.fence);
+        if (fenced.onComplete) {
+            fenced.onComplete(true);
+        }
+        completed++;
+    }
+    return completed;
+}
+
+size_t GLUploadThread::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_running + m_fenced.size();
+}
+
+void GLUploadThread::ThreadLoop() {
+    while (true) {
+        QueuedJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_running++;
+        }
+
+        job.upload();
+
+        // Flush so the fence actually reaches the GPU; otherwise the render
+        // thread could wait on a fence that was never submitted
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fenced.push_back({ fence, std::move(job.onComplete) });
+            m_running--;
+        }
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,65 @@
+#include "engine/gfx/GpuTimer.h"
+#include "engine/gfx/GLFunctions.h"
+#include <SDL3/SDL_log.h>
+
+namespace engine {
+
+GpuTimer::~GpuTimer() {
+    if (m_supported) {
+        glDeleteQueries(QUERY_COUNT, m_queries);
+    }
+}
+
+// Timer queries are core in GL 3.3, but some drivers still
+// leave the entry points null - in that case timing is disabled
+bool GpuTimer::Init() {
+    if (m_supported) return true;
+
+    if (!glGenQueries || !glDeleteQueries || !glBeginQuery || !glEndQuery ||
+        !glGetQueryObjectiv || !glGetQueryObjectui64v) {
+        SDL_Log("GpuTimer: Timer queries not available, GPU timing disabled");
+        return false;
+    }
+
+    glGenQueries(QUERY_COUNT, m_queries);
+    m_supported = true;
+    return true;
+}
+
+void GpuTimer::Begin() {
+    if (!m_supported || m_active) return;
+
+    // All queries still in flight: skip this frame rather than stall
+    if (m_pendingCount >= QUERY_COUNT) return;
+
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_writeIndex]);
+    m_active = true;
+}
+
+void GpuTimer::End() {
+    if (!m_active) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_active = false;
+    m_writeIndex = (m_writeIndex + 1) % QUERY_COUNT;
+    m_pendingCount++;
+}
+
+// Read back finished queries in submission order
+// Stops at the first query whose result is not available yet
+void GpuTimer::Collect() {
+    while (m_pendingCount > 0) {
+        int readIndex = (m_writeIndex - m_pendingCount + QUERY_COUNT) % QUERY_COUNT;
+
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[readIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 elapsedNS = 0;
+        glGetQueryObjectui64v(m_queries[readIndex], GL_QUERY_RESULT, &elapsedNS);
+        m_lastTimeMs = static_cast<float>(elapsedNS) / 1000000.0f;
+        m_pendingCount--;
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,272 @@
+#include "engine/gfx/PackedTileChunk.h"
+#include "engine/utils/Hash.h"
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+// Palettes up to this size are searched linearly, larger ones get a hash table
+constexpr size_t LINEAR_PALETTE_LIMIT = 16;
+
+size_t LookupSlot(int32_t value, size_t mask) {
+    return static_cast<size_t>(MixHash(static_cast<uint32_t>(value))) & mask;
+}
+
+// Smallest supported width that can address count palette entries
+int BitsFor(size_t count) {
+    if (count <= 1) return 0;
+    if (count <= 2) return 1;
+    if (count <= 4) return 2;
+    if (count <= 16) return 4;
+    if (count <= 256) return 8;
+    return 16;
+}
+
+size_t CapacityOf(int bits) {
+    return bits == 0 ? 1 : size_t(1) << bits;
+}
+
+size_t WordCountFor(int bits) {
+    return (static_cast<size_t>(PackedTileChunk::CELLS) * bits + 63) / 64;
+}
+
+// Widths divide 64, so cells never straddle words; a row is unpacked with
+// one load per word and a shift per cell
+template <int Bits>
+void UnpackRow(const uint64_t* words, int firstCell, const int32_t* palette, int32_t* out) {
+    constexpr int CELLS_PER_WORD = 64 / Bits;
+    constexpr uint64_t MASK = (uint64_t(1) << Bits) - 1;
+
+    size_t bit = static_cast<size_t>(firstCell) * Bits;
+    const uint64_t* word = words + (bit >> 6);
+    uint64_t bits = *word >> (bit & 63);
+    int left = static_cast<int>(64 - (bit & 63)) / Bits;
+
+    for (int x = 0; x < PackedTileChunk::SIZE; ++x) {
+        if (left == 0) {
+            bits = *++word;
+            left = CELLS_PER_WORD;
+        }
+        out[x] = palette[bits & MASK];
+        bits >>= Bits;
+        --left;
+    }
+}
+
+} // namespace
+
+PackedTileChunk::PackedTileChunk(int32_t value)
+    : m_palette{ value }
+{
+}
+
+int32_t PackedTileChunk::Get(int cell) const {
+    return m_bits == 0 ? m_palette[0] : m_palette[GetCell(cell)];
+}
+
+bool PackedTileChunk::Set(int cell, int32_t value) {
+    if (Get(cell) == value) return false;
+
+    uint32_t paletteIndex = FindOrAddValue(value);
+    SetCell(cell, paletteIndex);
+    return true;
+}
+
+void PackedTileChunk::Fill(int32_t value) {
+    m_palette.assign(1, value);
+    m_words.clear();
+    m_words.shrink_to_fit();
+    m_lookup.clear();
+    m_lookup.shrink_to_fit();
+    m_bits = 0;
+}
+
+void PackedTileChunk::DecodeRow(int y, int32_t* out) const {
+    int firstCell = y * SIZE;
+    switch (m_bits) {
+        case 0:  std::fill(out, out + SIZE, m_palette[0]); break;
+        case 1:  UnpackRow<1>(m_words.data(), firstCell, m_palette.data(), out); break;
+        case 2:  UnpackRow<2>(m_words.data(), firstCell, m_palette.data(), out); break;
+        case 4:  UnpackRow<4>(m_words.data(), firstCell, m_palette.data(), out); break;
+        case 8:  UnpackRow<8>(m_words.data(), firstCell, m_palette.data(), out); break;
+        default: UnpackRow<16>(m_words.data(), firstCell, m_palette.data(), out); break;
+    }
+}
+
+void PackedTileChunk::Decode(int32_t* out) const {
+    for (int y = 0; y < SIZE; ++y) {
+        DecodeRow(y, out + y * SIZE);
+    }
+}
+
+// The palette is collected first, so cells are written once instead of
+// being repacked each time the palette outgrows a width
+void PackedTileChunk::Encode(const int32_t* values) {
+    Fill(values[0]);
+
+    uint16_t indices[CELLS];
+    uint32_t runIndex = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        // Neighbouring cells usually repeat the last value
+        if (values[i] != m_palette[runIndex]) {
+            int found = FindValue(values[i]);
+            if (found < 0) {
+                m_palette.push_back(values[i]);
+                found = static_cast<int>(m_palette.size() - 1);
+                if (m_palette.size() > LINEAR_PALETTE_LIMIT) {
+                    if (m_lookup.size() < m_palette.size() * 2) {
+                        RebuildLookup();
+                    } else {
+                        InsertLookup(static_cast<uint32_t>(found));
+                    }
+                }
+            }
+            runIndex = static_cast<uint32_t>(found);
+        }
+        indices[i] = static_cast<uint16_t>(runIndex);
+    }
+
+    m_bits = BitsFor(m_palette.size());
+    if (m_bits == 0) return;
+
+    m_words.assign(WordCountFor(m_bits), 0);
+    for (int i = 0; i < CELLS; ++i) {
+        SetCell(i, indices[i]);
+    }
+}
+
+size_t PackedTileChunk::GetMemoryUsage() const {
+    return sizeof(*this) + m_palette.capacity() * sizeof(int32_t) +
+           m_words.capacity() * sizeof(uint64_t) + m_lookup.capacity() * sizeof(uint16_t);
+}
+
+uint32_t PackedTileChunk::GetCell(int cell) const {
+    size_t bit = static_cast<size_t>(cell) * m_bits;
+    uint64_t mask = (uint64_t(1) << m_bits) - 1;
+    return static_cast<uint32_t>((m_words[bit >> 6] >> (bit & 63)) & mask);
+}
+
+void PackedTileChunk::SetCell(int cell, uint32_t paletteIndex) {
+    size_t bit = static_cast<size_t>(cell) * m_bits;
+    uint64_t mask = (uint64_t(1) << m_bits) - 1;
+    uint64_t& word = m_words[bit >> 6];
+    word = (word & ~(mask << (bit & 63))) | (static_cast<uint64_t>(paletteIndex) << (bit & 63));
+}
+
+int PackedTileChunk::FindValue(int32_t value) const {
+    if (!m_lookup.empty()) {
+        size_t mask = m_lookup.size() - 1;
+        for (size_t slot = LookupSlot(value, mask); m_lookup[slot] != 0; slot = (slot + 1) & mask) {
+            if (m_palette[m_lookup[slot] - 1] == value) return m_lookup[slot] - 1;
+        }
+        return -1;
+    }
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        if (m_palette[i] == value) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// A full palette first drops values no cell uses any more (overwritten
+// tiles), and only widens the cells if that did not free a slot. A chunk
+// can't use more than CELLS values, so the palette is compacted at that
+// size too, bounding it for chunks that are rewritten over and over
+uint32_t PackedTileChunk::FindOrAddValue(int32_t value) {
+    int found = FindValue(value);
+    if (found >= 0) return static_cast<uint32_t>(found);
+
+    if (m_palette.size() >= CapacityOf(m_bits) || m_palette.size() >= static_cast<size_t>(CELLS)) {
+        Compact();
+        if (m_palette.size() >= CapacityOf(m_bits)) {
+            Repack(BitsFor(m_palette.size() + 1));
+        }
+    }
+
+    m_palette.push_back(value);
+    uint32_t paletteIndex = static_cast<uint32_t>(m_palette.size() - 1);
+    if (m_palette.size() > LINEAR_PALETTE_LIMIT) {
+        // Keep the table at most half full
+        if (m_lookup.size() < m_palette.size() * 2) {
+            RebuildLookup();
+        } else {
+            InsertLookup(paletteIndex);
+        }
+    }
+    return paletteIndex;
+}
+
+// Re-encode all cells at a new width, keeping the palette
+void PackedTileChunk::Repack(int bits) {
+    if (bits == m_bits) return;
+
+    uint16_t indices[CELLS];
+    for (int i = 0; i < CELLS; ++i) {
+        indices[i] = static_cast<uint16_t>(m_bits == 0 ? 0 : GetCell(i));
+    }
+
+    m_bits = bits;
+    m_words.assign(WordCountFor(bits), 0);
+    if (bits == 0) {
+        m_words.shrink_to_fit();
+        return;
+    }
+    for (int i = 0; i < CELLS; ++i) {
+        SetCell(i, indices[i]);
+    }
+}
+
+// Drop unused palette entries and pick the smallest width that still has
+// room for one more value (Compact is only called right before an add)
+void PackedTileChunk::Compact() {
+    if (m_bits == 0) return;
+
+    uint16_t indices[CELLS];
+    std::vector<int32_t> remap(m_palette.size(), -1);
+    std::vector<int32_t> palette;
+    for (int i = 0; i < CELLS; ++i) {
+        uint32_t old = GetCell(i);
+        if (remap[old] < 0) {
+            remap[old] = static_cast<int32_t>(palette.size());
+            palette.push_back(m_palette[old]);
+        }
+        indices[i] = static_cast<uint16_t>(remap[old]);
+    }
+    if (palette.size() == m_palette.size()) return;
+
+    m_palette = std::move(palette);
+    m_bits = BitsFor(m_palette.size() + 1);
+    m_words.assign(WordCountFor(m_bits), 0);
+    for (int i = 0; i < CELLS; ++i) {
+        SetCell(i, indices[i]);
+    }
+
+    if (m_palette.size() > LINEAR_PALETTE_LIMIT) {
+        RebuildLookup();
+    } else {
+        m_lookup.clear();
+        m_lookup.shrink_to_fit();
+    }
+}
+
+void PackedTileChunk::RebuildLookup() {
+    size_t slots = 32;
+    while (slots < m_palette.size() * 4) {
+        slots *= 2;
+    }
+    m_lookup.assign(slots, 0);
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        InsertLookup(static_cast<uint32_t>(i));
+    }
+}
+
+void PackedTileChunk::InsertLookup(uint32_t paletteIndex) {
+    size_t mask = m_lookup.size() - 1;
+    size_t slot = LookupSlot(m_palette[paletteIndex], mask);
+    while (m_lookup[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    m_lookup[slot] = static_cast<uint16_t>(paletteIndex + 1);
+}
+
+} // namespace engine
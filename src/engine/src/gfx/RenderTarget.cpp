@@ -0,0 +1,84 @@
+#include "engine/gfx/RenderTarget.h"
+#include "engine/gfx/GLFunctions.h"
+#include <SDL3/SDL_log.h>
+
+namespace engine {
+
+RenderTarget::RenderTarget(int width, int height, TextureFilter filter)
+    : m_width(width)
+    , m_height(height)
+    , m_filter(filter)
+{
+    Create();
+}
+
+RenderTarget::~RenderTarget() {
+    Destroy();
+}
+
+// Recreate attachments only when the size actually changes,
+// so calling this every frame with the same size is free
+void RenderTarget::Resize(int width, int height) {
+    if (width == m_width && height == m_height && IsValid()) {
+        return;
+    }
+    Destroy();
+    m_width = width;
+    m_height = height;
+    Create();
+}
+
+// Create the framebuffer with a single RGBA color texture attachment
+void RenderTarget::Create() {
+    if (m_width <= 0 || m_height <= 0) return;
+
+    // Empty texture, contents are written by rendering
+    m_colorTexture = std::make_unique<Texture2D>(nullptr, m_width, m_height, m_filter);
+
+    glGenFramebuffers(1, &m_framebufferID);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           m_colorTexture->GetID(), 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        SDL_Log("RenderTarget: Framebuffer incomplete (0x%x) at %dx%d", status, m_width, m_height);
+        Destroy();
+    }
+}
+
+void RenderTarget::Destroy() {
+    if (m_framebufferID != 0) {
+        glDeleteFramebuffers(1, &m_framebufferID);
+        m_framebufferID = 0;
+    }
+    m_colorTexture.reset();
+}
+
+void RenderTarget::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+    glViewport(0, 0, m_width, m_height);
+}
+
+void RenderTarget::Unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// Stretch the target onto the window
+// Uses the target's filter: Linear smooths the upscale, Nearest keeps pixel art crisp
+void RenderTarget::BlitToScreen(int screenWidth, int screenHeight) const {
+    if (!IsValid()) return;
+
+    GLenum glFilter = (m_filter == TextureFilter::Nearest) ? GL_NEAREST : GL_LINEAR;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebufferID);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, m_width, m_height,
+                      0, 0, screenWidth, screenHeight,
+                      GL_COLOR_BUFFER_BIT, glFilter);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+} // namespace engine
@@ -4,6 +4,8 @@
 #include "engine/gfx/VertexBuffer.h"
 #include "engine/gfx/IndexBuffer.h"
 #include "engine/gfx/Texture2D.h"
+#include "engine/gfx/TextureHandle.h"
+#include "engine/gfx/TileTypeTable.h"
 #include "engine/gfx/GLFunctions.h"
 #include "engine/gfx/GLUtils.h"
 #include "engine/gfx/Camera2D.h"
@@ -12,15 +14,20 @@
 
 namespace engine {
 
+// Texture unit of the tile type table (after the batch's sampler array)
+static constexpr uint32_t TILE_TYPES_UNIT = MAX_TEXTURE_SLOTS;
+
 // Embedded shader sources for batched rendering
+// (the vertex shader is preceded by #version and TileTypeTable::GLSL)
 static const char* s_vertexShaderSource = R"(
-#version 330 core
 layout(location = 0) in vec2 a_pos;
 layout(location = 1) in vec2 a_uv;
 layout(location = 2) in vec4 a_color;
 layout(location = 3) in float a_texIndex;
 
 uniform mat4 u_viewproj;
+uniform float u_time;
+uniform sampler2D u_tileTypes;
 
 out vec2 v_uv;
 out vec4 v_color;
@@ -30,6 +37,15 @@ void main() {
     v_uv = a_uv;
     v_color = a_color;
     v_texIndex = a_texIndex;
+    
+    // Animated tile (mesh vertices only): a_uv is the corner within the tile,
+    // the negative index packs tile type and phase
+    if (a_texIndex < 0.0) {
+        int packed = int(-a_texIndex) - 1;
+        vec4 rect = TileTypeRect(u_tileTypes, packed / 256, uint(packed % 256), u_time);
+        v_uv = mix(rect.xy, rect.zw, a_uv);
+        v_texIndex = 0.0;
+    }
     gl_Position = u_viewproj * vec4(a_pos, 0.0, 1.0);
 }
 )";
@@ -41,13 +57,14 @@ in vec4 v_color;
 flat in float v_texIndex;
 
 uniform sampler2D u_textures[16];
+uniform vec4 u_tint;
 
 out vec4 FragColor;
 
 void main() {
     int index = int(v_texIndex);
     vec4 texColor = texture(u_textures[index], v_uv);
-    FragColor = texColor * v_color;
+    FragColor = texColor * v_color * u_tint;
 }
 )";
 
@@ -105,7 +122,8 @@ void Renderer2D::Shutdown() {
 }
 
 void Renderer2D::CreateShader() {
-    m_shader = std::make_unique<Shader>(s_vertexShaderSource, s_fragmentShaderSource);
+    std::string vertexSource = std::string("#version 330 core\n") + TileTypeTable::GLSL + s_vertexShaderSource;
+    m_shader = std::make_unique<Shader>(vertexSource, s_fragmentShaderSource);
     
     // Set sampler uniforms once (texture unit indices never change)
     if (m_shader && m_shader->IsValid()) {
@@ -115,6 +133,7 @@ void Renderer2D::CreateShader() {
             snprintf(name, sizeof(name), "u_textures[%u]", i);
             m_shader->SetInt(name, static_cast<int>(i));
         }
+        m_shader->SetInt("u_tileTypes", static_cast<int>(TILE_TYPES_UNIT));
         m_shader->Unbind();
     }
 }
@@ -144,7 +163,12 @@ void Renderer2D::CreateQuadMesh() {
     // Configure VAO with batched vertex layout
     m_quadVAO->Bind();
     m_quadVBO->Bind();
-    
+    SetQuadVertexLayout();
+    m_quadIBO->Bind();
+    m_quadVAO->Unbind();
+}
+
+void Renderer2D::SetQuadVertexLayout() {
     // Position (vec2)
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, position));
     glEnableVertexAttribArray(0);
@@ -157,14 +181,28 @@ void Renderer2D::CreateQuadMesh() {
     // TexIndex (float)
     glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, texIndex));
     glEnableVertexAttribArray(3);
+}
+
+void Renderer2D::SetupMesh(VertexArray& mesh, const VertexBuffer& vbo) const {
+    if (!m_initialized) return;
     
+    mesh.Bind();
+    vbo.Bind();
+    SetQuadVertexLayout();
     m_quadIBO->Bind();
-    m_quadVAO->Unbind();
+    mesh.Unbind();
 }
 
 void Renderer2D::BeginFrame(const Camera2D& camera) {
     m_viewProjection = camera.GetViewProjectionMatrix();
     
+    // Screen corners in world space (screen Y points down, world Y up)
+    Vec2 topLeft = camera.ScreenToWorld(Vec2(0.0f, 0.0f));
+    Vec2 bottomRight = camera.ScreenToWorld(Vec2(camera.GetViewportWidth(), camera.GetViewportHeight()));
+    m_viewBounds = Vec4(topLeft.x, bottomRight.y, bottomRight.x, topLeft.y);
+    float viewWidth = bottomRight.x - topLeft.x;
+    m_pixelsPerUnit = viewWidth > 0.0f ? camera.GetViewportWidth() / viewWidth : 1.0f;
+    
     glClearColor(m_clearColor.x, m_clearColor.y, m_clearColor.z, m_clearColor.w);
     glClear(GL_COLOR_BUFFER_BIT);
     
@@ -190,6 +228,7 @@ void Renderer2D::Flush() {
     // Bind shader and set uniforms
     m_shader->Bind();
     m_shader->SetMat4("u_viewproj", m_viewProjection);
+    m_shader->SetVec4("u_tint", 1.0f, 1.0f, 1.0f, 1.0f);
     
     // Bind textures to all slots (unused slots get default texture)
     for (uint32_t i = 0; i < MAX_TEXTURE_SLOTS; ++i) {
@@ -208,6 +247,13 @@ void Renderer2D::Flush() {
     m_shader->Unbind();
 }
 
+void Renderer2D::FlushBatch() {
+    if (!m_initialized) return;
+    
+    Flush();
+    StartBatch();
+}
+
 void Renderer2D::DrawQuad(const Vec2& position, const Vec2& size, const Vec4& color) {
     AddQuadToBatch(position, size, 0.0f, color, nullptr, Vec4(0.0f, 0.0f, 1.0f, 1.0f), Flip::None);
 }
@@ -252,6 +298,56 @@ void Renderer2D::DrawQuad(const Vec2& position, const Vec2& size, float rotation
     AddQuadToBatch(position, size, rotation, tint, &texture, uvRect, flip);
 }
 
+void Renderer2D::DrawQuad(const Vec2& position, const Vec2& size, const TextureHandle& texture,
+                          const Vec4& tint) {
+    AddQuadToBatch(position, size, 0.0f, tint, ResolveHandle(texture),
+                   Vec4(0.0f, 0.0f, 1.0f, 1.0f), Flip::None);
+}
+
+void Renderer2D::DrawQuad(const Vec2& position, const Vec2& size, float rotation,
+                          const TextureHandle& texture, const Vec4& uvRect,
+                          Flip flip, const Vec4& tint) {
+    AddQuadToBatch(position, size, rotation, tint, ResolveHandle(texture), uvRect, flip);
+}
+
+void Renderer2D::DrawMesh(const VertexArray& mesh, uint32_t indexCount, const Texture2D& texture,
+                          const Vec2& offset, const Vec4& tint, const TileTypeTable* tileTypes) {
+    if (!m_initialized || indexCount == 0 || !texture.IsValid()) return;
+    
+    // Quads submitted before this mesh must end up below it
+    FlushBatch();
+    
+    // viewProjection * translate(offset): only the translation column changes
+    Mat4 transform = m_viewProjection;
+    for (int row = 0; row < 4; ++row) {
+        transform.m[12 + row] += m_viewProjection.m[row] * offset.x + m_viewProjection.m[4 + row] * offset.y;
+    }
+    
+    m_shader->Bind();
+    m_shader->SetMat4("u_viewproj", transform);
+    m_shader->SetVec4("u_tint", tint);
+    m_shader->SetFloat("u_time", m_time);
+    texture.Bind(0);
+    if (tileTypes) {
+        tileTypes->Bind(TILE_TYPES_UNIT);
+    }
+    
+    mesh.Bind();
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+    GL_CHECK_ERROR();
+    mesh.Unbind();
+    
+    m_shader->Unbind();
+}
+
+// nullptr makes AddQuadToBatch use the default white texture
+const Texture2D* Renderer2D::ResolveHandle(const TextureHandle& texture) const {
+    if (const Texture2D* loaded = texture.Get()) {
+        return loaded;
+    }
+    return m_placeholderTexture;
+}
+
 void Renderer2D::AddQuadToBatch(const Vec2& position, const Vec2& size, float rotation,
                                  const Vec4& color, const Texture2D* texture, const Vec4& uvRect,
                                  Flip flip) {
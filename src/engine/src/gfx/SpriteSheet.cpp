@@ -1,10 +1,11 @@
 #include "engine/gfx/SpriteSheet.h"
 #include "engine/utils/JsonParser.h"
 #include <SDL3/SDL_log.h>
+#include <algorithm>
 
 namespace engine {
 
-bool SpriteSheet::LoadFromFile(const std::string& jsonPath) {
+bool SpriteSheet::LoadFromFile(const std::string& jsonPath, bool keepPixels) {
     // Parse JSON file
     JsonValue root;
     if (!JsonParser::ParseFile(jsonPath, root)) {
@@ -30,9 +31,40 @@ bool SpriteSheet::LoadFromFile(const std::string& jsonPath) {
         dir = jsonPath.substr(0, lastSlash + 1);
     }
     
+    // Optional filter, mipmapped modes keep zoomed-out atlases cheap and alias-free
+    TextureFilter filter = TextureFilter::Linear;
+    if (root.HasKey("filter") && root["filter"].IsString()) {
+        const std::string& filterName = root["filter"].AsString();
+        if (filterName == "nearest") {
+            filter = TextureFilter::Nearest;
+        } else if (filterName == "linear") {
+            filter = TextureFilter::Linear;
+        } else if (filterName == "nearest_mipmap") {
+            filter = TextureFilter::NearestMipmap;
+        } else if (filterName == "linear_mipmap") {
+            filter = TextureFilter::LinearMipmap;
+        } else {
+            SDL_Log("Sprite sheet has unknown filter '%s', using linear: %s", 
+                    filterName.c_str(), jsonPath.c_str());
+        }
+    }
+    
     std::string texturePath = dir + root["texture"].AsString();
-    m_texture = std::make_shared<Texture2D>(texturePath);
-    if (!m_texture->IsValid()) {
+    m_pixels.reset();
+    if (keepPixels) {
+        // Decode once and upload from the same pixels
+        auto pixels = std::make_shared<TextureData>();
+        if (pixels->LoadFromFile(texturePath)) {
+            m_texture = std::make_shared<Texture2D>(*pixels, filter);
+            m_pixels = std::move(pixels);
+        } else {
+            m_texture.reset();
+        }
+    } else {
+        m_texture = std::make_shared<Texture2D>(texturePath, filter);
+    }
+    ++m_version;
+    if (!m_texture || !m_texture->IsValid()) {
         SDL_Log("Failed to load sprite sheet texture: %s", texturePath.c_str());
         return false;
     }
@@ -43,11 +75,28 @@ bool SpriteSheet::LoadFromFile(const std::string& jsonPath) {
         return false;
     }
     
+    if (root.HasKey("padding") && root["padding"].IsNumber()) {
+        m_mipPadding = root["padding"].AsInt();
+    }
+    ApplyMipPadding();
+    
     float texWidth = static_cast<float>(m_texture->GetWidth());
     float texHeight = static_cast<float>(m_texture->GetHeight());
     
+    // JSON objects are unordered: sort names so IDs are the same on every load
     const JsonValue& sprites = root["sprites"];
+    std::vector<std::pair<const std::string*, const JsonValue*>> entries;
     for (const auto& [name, spriteValue] : sprites) {
+        entries.emplace_back(&name, &spriteValue);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return *a.first < *b.first;
+    });
+    m_sprites.reserve(m_sprites.size() + entries.size());
+    
+    for (const auto& [namePtr, valuePtr] : entries) {
+        const std::string& name = *namePtr;
+        const JsonValue& spriteValue = *valuePtr;
         if (!spriteValue.IsObject()) continue;
         
         if (!spriteValue.HasKey("x") || !spriteValue.HasKey("y") ||
@@ -68,21 +117,61 @@ bool SpriteSheet::LoadFromFile(const std::string& jsonPath) {
         float minV = 1.0f - (y + h) / texHeight;
         float maxV = 1.0f - y / texHeight;
         
-        m_sprites[name] = Sprite(Vec4(minU, minV, maxU, maxV), w, h);
+        Sprite sprite(Vec4(minU, minV, maxU, maxV), w, h);
+        
+        // Trimmed by the atlas packer: where the region sat in the source image
+        if (spriteValue.HasKey("trim") && spriteValue["trim"].IsObject()) {
+            const JsonValue& trim = spriteValue["trim"];
+            if (trim.HasKey("x") && trim.HasKey("y") && trim.HasKey("w") && trim.HasKey("h")) {
+                sprite.trimX = trim["x"].AsInt();
+                sprite.trimY = trim["y"].AsInt();
+                sprite.sourceWidth = trim["w"].AsInt();
+                sprite.sourceHeight = trim["h"].AsInt();
+            } else {
+                SDL_Log("Sprite '%s' has incomplete trim, drawing it untrimmed", name.c_str());
+            }
+        }
+        
+        StoreSprite(name, sprite);
     }
     
+    // Name set is final, build the perfect hash for FindSprite
+    m_spriteNames.Build();
+    
     SDL_Log("Loaded sprite sheet '%s' with %zu sprites", jsonPath.c_str(), m_sprites.size());
     return true;
 }
 
-void SpriteSheet::SetTexture(std::shared_ptr<Texture2D> texture) {
+void SpriteSheet::SetTexture(std::shared_ptr<Texture2D> texture, std::shared_ptr<const TextureData> pixels) {
     m_texture = std::move(texture);
+    m_pixels = std::move(pixels);
+    ++m_version;
+    ApplyMipPadding();
+}
+
+void SpriteSheet::SetMipPadding(int padding) {
+    m_mipPadding = padding;
+    ApplyMipPadding();
+}
+
+// Clamp the texture's mip range so minified sprites stay inside their padding
+// At level L one texel covers 2^L pixels, so bleeding starts once 2^L > padding
+void SpriteSheet::ApplyMipPadding() {
+    if (m_mipPadding < 0 || !m_texture || m_texture->GetMipLevels() <= 1) {
+        return;
+    }
+    
+    int maxLevel = 0;
+    while ((2 << maxLevel) <= m_mipPadding) {
+        ++maxLevel;
+    }
+    m_texture->SetMaxMipLevel(maxLevel);
 }
 
-void SpriteSheet::AddSprite(const std::string& name, int x, int y, int width, int height) {
+SpriteId SpriteSheet::AddSprite(const std::string& name, int x, int y, int width, int height) {
     if (!m_texture || !m_texture->IsValid()) {
         SDL_Log("Cannot add sprite: no valid texture set");
-        return;
+        return INVALID_SPRITE_ID;
     }
     
     float texWidth = static_cast<float>(m_texture->GetWidth());
@@ -94,16 +183,44 @@ void SpriteSheet::AddSprite(const std::string& name, int x, int y, int width, in
     float minV = 1.0f - (y + height) / texHeight;
     float maxV = 1.0f - y / texHeight;
     
-    m_sprites[name] = Sprite(Vec4(minU, minV, maxU, maxV), width, height);
+    return StoreSprite(name, Sprite(Vec4(minU, minV, maxU, maxV), width, height));
+}
+
+// Append a new sprite or overwrite an existing one in place (its ID stays valid)
+SpriteId SpriteSheet::StoreSprite(const std::string& name, const Sprite& sprite) {
+    uint32_t index = m_spriteNames.Add(name);
+    if (index == NameTable::NOT_FOUND) {
+        return INVALID_SPRITE_ID;
+    }
+    
+    ++m_version;
+    if (index < m_sprites.size()) {
+        m_sprites[index] = sprite;
+    } else {
+        m_sprites.push_back(sprite);
+    }
+    return static_cast<SpriteId>(index);
+}
+
+SpriteId SpriteSheet::FindSprite(const std::string& name) const {
+    return FindSprite(HashString(name));
+}
+
+SpriteId SpriteSheet::FindSprite(uint64_t nameHash) const {
+    uint32_t index = m_spriteNames.Find(nameHash);
+    return index != NameTable::NOT_FOUND ? static_cast<SpriteId>(index) : INVALID_SPRITE_ID;
 }
 
 const Sprite* SpriteSheet::GetSprite(const std::string& name) const {
-    auto it = m_sprites.find(name);
-    return it != m_sprites.end() ? &it->second : nullptr;
+    return GetSprite(FindSprite(name));
+}
+
+const std::string& SpriteSheet::GetSpriteName(SpriteId id) const {
+    return m_spriteNames.GetName(static_cast<uint32_t>(id));
 }
 
 bool SpriteSheet::HasSprite(const std::string& name) const {
-    return m_sprites.find(name) != m_sprites.end();
+    return FindSprite(name) != INVALID_SPRITE_ID;
 }
 
 } // namespace engine
@@ -1,24 +1,27 @@
 #include "engine/gfx/Texture2D.h"
 #include "engine/gfx/GLFunctions.h"
+#include "engine/gfx/CookedTexture.h"
+#include "engine/gfx/TextureData.h"
+#include "engine/platform/MappedFile.h"
 #include <SDL3/SDL_opengl.h>
 #include <SDL3/SDL_log.h>
-#include <stb_image.h>
 
 namespace engine {
 
 Texture2D::Texture2D(const std::string& path, TextureFilter filter) {
-    // Load image using stb_image (supports PNG, JPG, BMP, etc.)
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);  // OpenGL expects bottom-left origin
-    uint8_t* data = stbi_load(path.c_str(), &width, &height, &channels, 4);  // Force RGBA
+    // Cooked textures skip decoding entirely
+    if (CookedTexture::IsCookedPath(path)) {
+        LoadCooked(path, filter);
+        return;
+    }
     
-    if (!data) {
-        SDL_Log("Failed to load texture '%s': %s", path.c_str(), stbi_failure_reason());
+    // Decode image (PNG, JPG, BMP, etc.), flipped for OpenGL's bottom-left origin
+    TextureData image;
+    if (!image.LoadFromFile(path)) {
         return;
     }
     
-    CreateFromData(data, width, height, filter);
-    stbi_image_free(data);
+    CreateFromData(image.pixels.data(), image.width, image.height, filter);
     
     if (m_textureID != 0) {
         SDL_Log("Loaded texture '%s' (%dx%d)", path.c_str(), m_width, m_height);
@@ -29,6 +32,40 @@ Texture2D::Texture2D(const uint8_t* data, int width, int height, TextureFilter f
     CreateFromData(data, width, height, filter);
 }
 
+Texture2D::Texture2D(const TextureData& data, TextureFilter filter) {
+    if (!data.IsValid()) return;
+    
+    const uint8_t* levels[BTEX_MAX_LEVELS] = {};
+    int levelCount = data.levelCount < BTEX_MAX_LEVELS ? data.levelCount : BTEX_MAX_LEVELS;
+    for (int i = 0; i < levelCount; ++i) {
+        levels[i] = data.GetLevelData(i);
+    }
+    CreateFromLevels(levels, levelCount, data.width, data.height, filter);
+}
+
+// Map the file and upload straight from the mapping
+// Rows are already bottom-up, so no flip or copy is needed
+void Texture2D::LoadCooked(const std::string& path, TextureFilter filter) {
+    MappedFile file(path);
+    if (!file.IsOpen()) {
+        SDL_Log("Failed to load cooked texture '%s'", path.c_str());
+        return;
+    }
+    
+    CookedTextureView view;
+    if (!CookedTexture::Parse(file.GetData(), file.GetSize(), view)) {
+        SDL_Log("Invalid cooked texture '%s'", path.c_str());
+        return;
+    }
+    
+    CreateFromLevels(view.levels, view.levelCount, view.width, view.height, filter);
+    
+    if (m_textureID != 0) {
+        SDL_Log("Loaded cooked texture '%s' (%dx%d, %d stored levels)", 
+                path.c_str(), m_width, m_height, view.levelCount);
+    }
+}
+
 Texture2D::~Texture2D() {
     if (m_textureID != 0) {
         glDeleteTextures(1, &m_textureID);
@@ -38,10 +75,13 @@ Texture2D::~Texture2D() {
 Texture2D::Texture2D(Texture2D&& other) noexcept
     : m_textureID(other.m_textureID)
     , m_width(other.m_width)
-    , m_height(other.m_height) {
+    , m_height(other.m_height)
+    , m_mipLevels(other.m_mipLevels)
+    , m_filter(other.m_filter) {
     other.m_textureID = 0;
     other.m_width = 0;
     other.m_height = 0;
+    other.m_mipLevels = 1;
 }
 
 Texture2D& Texture2D::operator=(Texture2D&& other) noexcept {
@@ -54,20 +94,41 @@ Texture2D& Texture2D::operator=(Texture2D&& other) noexcept {
         m_textureID = other.m_textureID;
         m_width = other.m_width;
         m_height = other.m_height;
+        m_mipLevels = other.m_mipLevels;
+        m_filter = other.m_filter;
         other.m_textureID = 0;
         other.m_width = 0;
         other.m_height = 0;
+        other.m_mipLevels = 1;
     }
     return *this;
 }
 
 // Upload RGBA pixel data to GPU and create OpenGL texture
-// data: RGBA pixel data (4 bytes per pixel)
+// data: RGBA pixel data (4 bytes per pixel), may be null for render targets
 // width/height: image dimensions in pixels
-// filter: Nearest for pixel art, Linear for smooth scaling
+// filter: Nearest for pixel art, Linear for smooth scaling, *Mipmap to build a mip chain
 void Texture2D::CreateFromData(const uint8_t* data, int width, int height, TextureFilter filter) {
+    CreateFromLevels(&data, 1, width, height, filter);
+}
+
+// Upload a (possibly partial) mip chain
+// A single level is expanded on the GPU for mipmapped filters;
+// a cooked chain is used as-is, even if it stops before 1x1
+void Texture2D::CreateFromLevels(const uint8_t* const* levels, int levelCount,
+                                 int width, int height, TextureFilter filter) {
+    const uint8_t* data = levelCount > 0 ? levels[0] : nullptr;
+    
     m_width = width;
     m_height = height;
+    m_filter = filter;
+    m_mipLevels = 1;
+    if (IsMipmapped(filter)) {
+        int fullChain = ComputeMipLevels(width, height);
+        m_mipLevels = (levelCount > 1 && levelCount < fullChain) ? levelCount : fullChain;
+    }
+    int providedLevels = levelCount < m_mipLevels ? levelCount : m_mipLevels;
+    if (providedLevels < 1) providedLevels = 1;
     
     glGenTextures(1, &m_textureID);
     glBindTexture(GL_TEXTURE_2D, m_textureID);
@@ -76,21 +137,108 @@ void Texture2D::CreateFromData(const uint8_t* data, int width, int height, Textu
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     
-    // Texture filtering: Nearest for pixel-perfect, Linear for smooth
-    GLenum glFilter = (filter == TextureFilter::Nearest) ? GL_NEAREST : GL_LINEAR;
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glFilter);
+    // Texture filtering: magnification uses the base mode,
+    // minification blends between mips when a chain exists
+    GLenum magFilter = GL_LINEAR;
+    GLenum minFilter = GL_LINEAR;
+    switch (filter) {
+        case TextureFilter::Nearest:
+            magFilter = GL_NEAREST;
+            minFilter = GL_NEAREST;
+            break;
+        case TextureFilter::Linear:
+            break;
+        case TextureFilter::NearestMipmap:
+            magFilter = GL_NEAREST;
+            minFilter = GL_NEAREST_MIPMAP_LINEAR;
+            break;
+        case TextureFilter::LinearMipmap:
+            minFilter = GL_LINEAR_MIPMAP_LINEAR;
+            break;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_mipLevels - 1);
     
     // Upload pixel data to GPU
-    // GL_RGBA: internal format and source format
+    // GL_RGBA8: sized internal format, GL_RGBA source format
     // GL_UNSIGNED_BYTE: 8 bits per channel
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, 
-                 GL_RGBA, GL_UNSIGNED_BYTE, data);
+    if (glTexStorage2D) {
+        // Immutable storage: the whole mip chain is allocated once, up front,
+        // so the driver never has to revalidate or reallocate levels
+        glTexStorage2D(GL_TEXTURE_2D, m_mipLevels, GL_RGBA8, width, height);
+    }
     
+    // Without pixels every level is allocated empty (glTexStorage2D already did that)
+    int allocatedLevels = data ? providedLevels : m_mipLevels;
+    int levelWidth = width;
+    int levelHeight = height;
+    for (int level = 0; level < allocatedLevels; ++level) {
+        const uint8_t* levelData = levelCount > level ? levels[level] : nullptr;
+        if (glTexStorage2D) {
+            if (levelData) {
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, levelWidth, levelHeight,
+                                GL_RGBA, GL_UNSIGNED_BYTE, levelData);
+            }
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, levelWidth, levelHeight, 0, 
+                         GL_RGBA, GL_UNSIGNED_BYTE, levelData);
+        }
+        levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+        levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+    }
+    
+    // Build the rest of the chain from level 0
+    if (m_mipLevels > providedLevels && data) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    static const char* filterNames[] = { "nearest", "linear", "nearest+mips", "linear+mips" };
+    SDL_Log("Created texture ID=%u (%dx%d, %s, %d levels)", m_textureID, width, height, 
+            filterNames[static_cast<int>(filter)], m_mipLevels);
+}
+
+// Full chain goes down to 1x1: floor(log2(max(width, height))) + 1
+int Texture2D::ComputeMipLevels(int width, int height) {
+    int size = width > height ? width : height;
+    int levels = 1;
+    while (size > 1) {
+        size >>= 1;
+        ++levels;
+    }
+    return levels;
+}
+
+void Texture2D::SetMaxMipLevel(int level) {
+    if (m_textureID == 0) return;
+    
+    if (level < 0) level = 0;
+    if (level > m_mipLevels - 1) level = m_mipLevels - 1;
+    
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::Update(int x, int y, int width, int height, const uint8_t* data) {
+    if (m_textureID == 0 || !data || width <= 0 || height <= 0) return;
+    
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    if (m_mipLevels > 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::UpdateLevel(int level, int x, int y, int width, int height, const uint8_t* data) {
+    if (m_textureID == 0 || !data || width <= 0 || height <= 0 || level < 0 || level >= m_mipLevels) return;
     
-    const char* filterName = (filter == TextureFilter::Nearest) ? "nearest" : "linear";
-    SDL_Log("Created texture ID=%u (%dx%d, %s)", m_textureID, width, height, filterName);
+    glBindTexture(GL_TEXTURE_2D, m_textureID);
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 // Bind texture to a texture slot for sampling in shaders
@@ -1,50 +1,461 @@
 #include "engine/gfx/TextureCache.h"
+#include "engine/gfx/CookedTexture.h"
+#include "engine/gfx/TextureData.h"
+#include "engine/gfx/GLUploadThread.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/utils/Hash.h"
 #include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
 
 namespace engine {
 
-std::shared_ptr<Texture2D> TextureCache::Load(const std::string& path, TextureFilter filter) {
-    // Check if already cached and still alive
-    auto it = m_cache.find(path);
-    if (it != m_cache.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing;
+// Hand-off point between decode workers and the GL thread
+struct TextureCache::DecodeQueue {
+    struct Result {
+        uint64_t key;
+        TextureFilter filter;
+        TextureData data;
+        uint64_t generation;
+    };
+
+    std::mutex mutex;
+    std::condition_variable resultReady;
+    std::deque<Result> results;
+    uint64_t generation = 0;  // Bumped by Clear() so stale results are dropped
+};
+
+TextureCache::TextureCache()
+    : m_glThread(std::this_thread::get_id())
+    , m_decodeQueue(std::make_shared<DecodeQueue>())
+    , m_alive(std::make_shared<bool>(true)) {
+}
+
+TextureCache::~TextureCache() {
+    // Private pool joins here; queued jobs only touch the shared DecodeQueue
+    m_ownedPool.reset();
+}
+
+std::shared_ptr<Texture2D> TextureCache::Find(uint64_t key, const std::string& path) {
+    Shard& shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end() || it->second.path != path) {
+        return nullptr;
+    }
+    it->second.lastUsedFrame.store(m_frameIndex.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+    return it->second.texture;
+}
+
+void TextureCache::Insert(uint64_t key, const std::string& path,
+                          const std::shared_ptr<Texture2D>& texture) {
+    size_t bytes = EstimateBytes(*texture);
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        CacheEntry& entry = shard.entries[key];
+        if (!entry.path.empty() && entry.path != path) {
+            SDL_Log("TextureCache: Hash collision between '%s' and '%s'",
+                    entry.path.c_str(), path.c_str());
         }
-        // weak_ptr expired, will reload below (i.e. texture is no longer in use)
+        m_residentBytes -= entry.bytes;  // 0 for new entries
+
+        entry.path = path;
+        entry.texture = texture;
+        entry.bytes = bytes;
+        entry.lastUsedFrame.store(m_frameIndex.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+        m_residentBytes += bytes;
+    }
+
+    EvictToBudget();
+}
+
+std::shared_ptr<Texture2D> TextureCache::Load(const std::string& path, TextureFilter filter) {
+    uint64_t key = HashString(path);
+
+    // Check if already cached (in use or kept by the LRU)
+    if (auto existing = Find(key, path)) {
+        return existing;
+    }
+
+    if (!IsGLThread()) {
+        SDL_Log("TextureCache: Load('%s') called off the GL thread, use LoadAsync()", path.c_str());
+        return nullptr;
     }
 
-    // Cache miss: load from disk
-    auto texture = std::make_shared<Texture2D>(path, filter);
+    // Cache miss: load from disk (cooked version if available)
+    auto texture = std::make_shared<Texture2D>(ResolveSourcePath(path), filter);
     if (!texture->IsValid()) {
         SDL_Log("TextureCache: Failed to load '%s'", path.c_str());
         return nullptr;
     }
 
-    m_cache[path] = texture;
-    SDL_Log("TextureCache: Loaded '%s' (%dx%d)", 
+    Insert(key, path, texture);
+    SDL_Log("TextureCache: Loaded '%s' (%dx%d)",
             path.c_str(), texture->GetWidth(), texture->GetHeight());
     return texture;
 }
 
-void TextureCache::Preload(const std::vector<std::string>& paths, TextureFilter filter) {
+std::shared_ptr<Texture2D> TextureCache::Get(const std::string& path) {
+    return Find(HashString(path), path);
+}
+
+bool TextureCache::Contains(const std::string& path) const {
+    uint64_t key = HashString(path);
+    const Shard& shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(key);
+    return it != shard.entries.end() && it->second.path == path;
+}
+
+// Prefer "name.btex" next to "name.png" when it is at least as new as the source,
+// so stale cooked files never hide edited art
+std::string TextureCache::ResolveSourcePath(const std::string& path) {
+    if (CookedTexture::IsCookedPath(path)) {
+        return path;
+    }
+
+    std::string cookedPath = CookedTexture::GetCookedPath(path);
+    std::error_code ec;
+    if (!std::filesystem::exists(cookedPath, ec)) {
+        return path;
+    }
+
+    auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+    if (ec) return path;
+    auto sourceTime = std::filesystem::last_write_time(path, ec);
+    if (!ec && sourceTime > cookedTime) {
+        SDL_Log("TextureCache: '%s' is older than its source, ignoring", cookedPath.c_str());
+        return path;
+    }
+    return cookedPath;
+}
+
+// Called with m_pendingMutex held
+ThreadPool& TextureCache::GetThreadPool() {
+    if (m_threadPool) {
+        return *m_threadPool;
+    }
+    if (!m_ownedPool) {
+        m_ownedPool = std::make_unique<ThreadPool>();
+    }
+    return *m_ownedPool;
+}
+
+// Start decoding a path on a worker, or join the decode already running
+// Workers only decode (no GL); results wait in the DecodeQueue for Update()
+// Called with m_pendingMutex held
+TextureCache::PendingLoad& TextureCache::QueueDecode(uint64_t key, const std::string& path,
+                                                     TextureFilter filter) {
+    auto [it, inserted] = m_inFlight.try_emplace(key);
+    if (!inserted) {
+        return it->second;  // Already queued
+    }
+    it->second.path = path;
+
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_decodeQueue->mutex);
+        generation = m_decodeQueue->generation;
+    }
+
+    std::shared_ptr<DecodeQueue> queue = m_decodeQueue;
+    std::string sourcePath = ResolveSourcePath(path);
+    GetThreadPool().Submit([queue, key, sourcePath, filter, generation]() {
+        DecodeQueue::Result result{ key, filter, TextureData(), generation };
+        result.data.LoadFromFile(sourcePath);  // Failure is reported at upload time
+
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->results.push_back(std::move(result));
+        }
+        queue->resultReady.notify_one();
+    });
+    return it->second;
+}
+
+TextureHandle TextureCache::LoadAsync(const std::string& path, TextureFilter filter) {
+    uint64_t key = HashString(path);
+    if (auto existing = Find(key, path)) {
+        auto slot = std::make_shared<TextureHandle::Slot>();
+        slot->path = path;
+        slot->texture = std::move(existing);
+        slot->state.store(TextureHandle::State::Ready, std::memory_order_release);
+        return TextureHandle(std::move(slot));
+    }
+
+    // Every LoadAsync() of the same path shares one slot until it resolves
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    PendingLoad& pending = QueueDecode(key, path, filter);
+    if (!pending.handle) {
+        pending.handle = std::make_shared<TextureHandle::Slot>();
+        pending.handle->path = path;
+    }
+    return TextureHandle(pending.handle);
+}
+
+// Queue decode jobs for every path not already resident
+void TextureCache::PreloadAsync(const std::vector<std::string>& paths, TextureFilter filter) {
     for (const auto& path : paths) {
-        Load(path, filter);
+        uint64_t key = HashString(path);
+        if (!Find(key, path)) {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            QueueDecode(key, path, filter);
+        }
     }
 }
 
+size_t TextureCache::Update(size_t uploadBudgetBytes) {
+    uint64_t frame = ++m_frameIndex;
+
+    // Anything referenced outside the cache counts as used this frame
+    for (Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto& [key, entry] : shard.entries) {
+            if (entry.texture.use_count() > 1) {
+                entry.lastUsedFrame.store(frame, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t uploaded = UploadDecoded(uploadBudgetBytes, true);
+    EvictToBudget();
+    return uploaded;
+}
+
+// Upload finished decodes on the GL thread within a byte budget
+// With an upload thread, decodes are handed over instead (no budget needed)
+size_t TextureCache::UploadDecoded(size_t uploadBudgetBytes, bool useUploadThread) {
+    size_t uploaded = 0;
+    size_t bytesUsed = 0;
+
+    while (uploaded == 0 || bytesUsed < uploadBudgetBytes) {
+        DecodeQueue::Result result;
+        {
+            std::lock_guard<std::mutex> lock(m_decodeQueue->mutex);
+            if (m_decodeQueue->results.empty()) break;
+            result = std::move(m_decodeQueue->results.front());
+            m_decodeQueue->results.pop_front();
+            if (result.generation != m_decodeQueue->generation) {
+                continue;  // Requested before Clear()
+            }
+        }
+
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            auto pendingIt = m_inFlight.find(result.key);
+            if (pendingIt == m_inFlight.end()) continue;
+            path = pendingIt->second.path;
+        }
+
+        // A synchronous Load() may have beaten the decode
+        std::shared_ptr<Texture2D> texture = Find(result.key, path);
+        if (!texture && result.data.IsValid()) {
+            if (useUploadThread && m_uploadThread && m_uploadThread->IsRunning()) {
+                SubmitUpload(result.key, result.filter, std::move(result.data), result.generation);
+                uploaded++;
+                continue;  // Finished from the upload thread's completion
+            }
+
+            texture = std::make_shared<Texture2D>(result.data, result.filter);
+            if (texture->IsValid()) {
+                bytesUsed += result.data.GetSizeBytes();
+                uploaded++;
+            } else {
+                texture.reset();
+            }
+        }
+        FinishLoad(result.key, std::move(texture));
+    }
+
+    return uploaded;
+}
+
+// Upload on the loader context; publish from the render thread once fenced
+void TextureCache::SubmitUpload(uint64_t key, TextureFilter filter, TextureData&& data,
+                                uint64_t generation) {
+    auto pixels = std::make_shared<TextureData>(std::move(data));
+    auto texture = std::make_shared<std::shared_ptr<Texture2D>>();
+    std::weak_ptr<bool> alive = m_alive;
+
+    m_uploadThread->Submit(
+        [pixels, texture, filter]() {
+            auto uploaded = std::make_shared<Texture2D>(*pixels, filter);
+            if (uploaded->IsValid()) {
+                *texture = std::move(uploaded);
+            }
+        },
+        [this, alive, key, texture, generation](bool uploaded) {
+            if (alive.expired()) return;  // Cache destroyed meanwhile
+            {
+                std::lock_guard<std::mutex> lock(m_decodeQueue->mutex);
+                if (generation != m_decodeQueue->generation) return;  // Requested before Clear()
+            }
+            // Skipped by GLUploadThread::Stop: resolve as failed rather than leave it pending
+            FinishLoad(key, uploaded ? std::move(*texture) : nullptr);
+        });
+}
+
+// Publish a finished load (texture == nullptr if it failed)
+void TextureCache::FinishLoad(uint64_t key, std::shared_ptr<Texture2D> texture) {
+    PendingLoad pending;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        auto pendingIt = m_inFlight.find(key);
+        if (pendingIt == m_inFlight.end()) return;
+        pending = std::move(pendingIt->second);
+        m_inFlight.erase(pendingIt);
+    }
+
+    if (texture) {
+        if (!Find(key, pending.path)) {
+            Insert(key, pending.path, texture);  // Not evictable yet, we still hold a reference
+        }
+    } else {
+        SDL_Log("TextureCache: Failed to load '%s'", pending.path.c_str());
+    }
+    if (pending.handle) {
+        TextureHandle::Resolve(pending.handle, std::move(texture));
+    }
+}
+
+// Blocking preload: decode in parallel, upload on this thread as results arrive
+void TextureCache::Preload(const std::vector<std::string>& paths, TextureFilter filter) {
+    PreloadAsync(paths, filter);
+
+    while (GetPendingCount() > 0) {
+        {
+            // Timed: loads handed to the upload thread earlier finish through Poll(), not the queue
+            std::unique_lock<std::mutex> lock(m_decodeQueue->mutex);
+            m_decodeQueue->resultReady.wait_for(lock, std::chrono::milliseconds(2),
+                                                [this] { return !m_decodeQueue->results.empty(); });
+        }
+        UploadDecoded(SIZE_MAX, false);
+        if (m_uploadThread) {
+            m_uploadThread->Poll();
+        }
+    }
+    SDL_Log("TextureCache: Preloaded %zu textures", paths.size());
+}
+
+size_t TextureCache::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    return m_inFlight.size();
+}
+
 void TextureCache::Clear() {
-    m_cache.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_decodeQueue->mutex);
+        m_decodeQueue->generation++;
+        m_decodeQueue->results.clear();
+    }
+
+    // Nobody will upload these any more, don't leave handles pending forever
+    std::unordered_map<uint64_t, PendingLoad> inFlight;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        inFlight.swap(m_inFlight);
+    }
+    for (auto& [key, pending] : inFlight) {
+        if (pending.handle) {
+            TextureHandle::Resolve(pending.handle, nullptr);
+        }
+    }
+
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+    m_residentBytes = 0;
 }
 
 size_t TextureCache::GetCachedCount() const {
     size_t count = 0;
-    for (const auto& [path, weak] : m_cache) {
-        if (!weak.expired()) {
-            ++count;
-        }
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.entries.size();
     }
     return count;
 }
 
-} // namespace engine
+void TextureCache::SetMemoryBudget(size_t bytes) {
+    m_memoryBudget = bytes;
+    EvictToBudget();
+}
 
+// Release unused textures, least recently used first, until under budget
+// In-use textures are skipped: dropping the cache's reference would not free them
+void TextureCache::EvictToBudget() {
+    if (m_residentBytes <= m_memoryBudget) return;
+
+    struct Candidate {
+        uint64_t key;
+        uint64_t lastUsedFrame;
+    };
+    std::vector<Candidate> candidates;
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [key, entry] : shard.entries) {
+            if (entry.texture.use_count() == 1) {
+                candidates.push_back({ key, entry.lastUsedFrame.load(std::memory_order_relaxed) });
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.lastUsedFrame < b.lastUsedFrame;
+    });
+
+    for (const Candidate& candidate : candidates) {
+        if (m_residentBytes <= m_memoryBudget) break;
+
+        // Destroy the texture outside the lock (glDeleteTextures can be slow)
+        std::shared_ptr<Texture2D> evicted;
+        {
+            Shard& shard = GetShard(candidate.key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.entries.find(candidate.key);
+            if (it == shard.entries.end() || it->second.texture.use_count() != 1) {
+                continue;  // Picked up by another thread since the scan
+            }
+            SDL_Log("TextureCache: Evicting '%s' (%zu KB, last used frame %llu)",
+                    it->second.path.c_str(), it->second.bytes / 1024,
+                    static_cast<unsigned long long>(candidate.lastUsedFrame));
+            m_residentBytes -= it->second.bytes;
+            evicted = std::move(it->second.texture);
+            shard.entries.erase(it);
+        }
+    }
+}
+
+std::vector<TextureCache::ResidencyInfo> TextureCache::GetResidency() const {
+    std::vector<ResidencyInfo> info;
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [key, entry] : shard.entries) {
+            info.push_back({ entry.path, entry.bytes,
+                             entry.lastUsedFrame.load(std::memory_order_relaxed),
+                             entry.texture.use_count() > 1 });
+        }
+    }
+    return info;
+}
+
+size_t TextureCache::EstimateBytes(const Texture2D& texture) {
+    constexpr size_t BYTES_PER_PIXEL = 4;  // Always uploaded as RGBA8
+    size_t bytes = static_cast<size_t>(texture.GetWidth()) * texture.GetHeight() * BYTES_PER_PIXEL;
+    if (texture.GetMipLevels() > 1) {
+        bytes += bytes / 3;  // Full chain adds 1/4 + 1/16 + ... = 1/3
+    }
+    return bytes;
+}
+
+} // namespace engine
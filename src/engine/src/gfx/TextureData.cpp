@@ -0,0 +1,81 @@
+#include "engine/gfx/TextureData.h"
+#include "engine/gfx/CookedTexture.h"
+#include "engine/platform/MappedFile.h"
+#include <SDL3/SDL_log.h>
+#include <stb_image.h>
+#include <cstring>
+
+namespace engine {
+
+// Map the file and decode from memory
+// stb_image keeps the flip flag and failure reason per thread,
+// so concurrent calls from worker threads do not interfere
+bool TextureData::LoadFromFile(const std::string& path) {
+    pixels.clear();
+    width = 0;
+    height = 0;
+    levelCount = 0;
+
+    MappedFile file(path);
+    if (!file.IsOpen()) {
+        SDL_Log("Failed to load texture '%s': cannot open file", path.c_str());
+        return false;
+    }
+
+    // Cooked textures are already in upload layout: just copy the levels out
+    if (CookedTexture::IsCookedPath(path)) {
+        CookedTextureView view;
+        if (!CookedTexture::Parse(file.GetData(), file.GetSize(), view)) {
+            SDL_Log("Invalid cooked texture '%s'", path.c_str());
+            return false;
+        }
+        const uint8_t* payload = view.levels[0];
+        const uint8_t* payloadEnd = payload;
+        int w = view.width;
+        int h = view.height;
+        for (int level = 0; level < view.levelCount; ++level) {
+            payloadEnd += CookedTexture::GetLevelSize(BtexFormat::RGBA8, w, h);
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+        }
+        pixels.assign(payload, payloadEnd);
+        width = view.width;
+        height = view.height;
+        levelCount = view.levelCount;
+        return true;
+    }
+
+    stbi_set_flip_vertically_on_load_thread(true);  // OpenGL expects bottom-left origin
+    int channels;
+    uint8_t* decoded = stbi_load_from_memory(file.GetData(), static_cast<int>(file.GetSize()),
+                                             &width, &height, &channels, 4);  // Force RGBA
+    if (!decoded) {
+        SDL_Log("Failed to load texture '%s': %s", path.c_str(), stbi_failure_reason());
+        width = 0;
+        height = 0;
+        return false;
+    }
+
+    pixels.assign(decoded, decoded + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(decoded);
+    levelCount = 1;
+    return true;
+}
+
+const uint8_t* TextureData::GetLevelData(int level) const {
+    if (level < 0 || level >= levelCount) {
+        return nullptr;
+    }
+
+    size_t offset = 0;
+    int w = width;
+    int h = height;
+    for (int i = 0; i < level; ++i) {
+        offset += static_cast<size_t>(w) * h * 4;
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+    return pixels.data() + offset;
+}
+
+} // namespace engine
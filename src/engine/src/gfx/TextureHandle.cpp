@@ -0,0 +1,68 @@
+#include "engine/gfx/TextureHandle.h"
+#include "engine/gfx/Texture2D.h"
+
+namespace engine {
+
+TextureHandle::State TextureHandle::GetState() const {
+    return m_slot ? m_slot->state.load(std::memory_order_acquire) : State::Empty;
+}
+
+Texture2D* TextureHandle::Get() const {
+    if (GetState() != State::Ready) {
+        return nullptr;
+    }
+    return m_slot->texture.get();
+}
+
+std::shared_ptr<Texture2D> TextureHandle::GetShared() const {
+    if (GetState() != State::Ready) {
+        return nullptr;
+    }
+    return m_slot->texture;
+}
+
+const Texture2D& TextureHandle::GetOr(const Texture2D& fallback) const {
+    const Texture2D* texture = Get();
+    return texture ? *texture : fallback;
+}
+
+const std::string& TextureHandle::GetPath() const {
+    static const std::string empty;
+    return m_slot ? m_slot->path : empty;
+}
+
+void TextureHandle::OnReady(ReadyCallback callback) const {
+    if (!m_slot || !callback) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_slot->callbackMutex);
+        if (m_slot->state.load(std::memory_order_acquire) == State::Pending) {
+            m_slot->callbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback(*this);
+}
+
+void TextureHandle::Resolve(const std::shared_ptr<Slot>& slot, std::shared_ptr<Texture2D> texture) {
+    std::vector<ReadyCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(slot->callbackMutex);
+        if (slot->state.load(std::memory_order_relaxed) != State::Pending) return;
+
+        State state = texture ? State::Ready : State::Failed;
+        slot->texture = std::move(texture);
+        slot->state.store(state, std::memory_order_release);
+
+        // Run outside the lock: a callback may register further callbacks on this handle
+        callbacks = std::move(slot->callbacks);
+        slot->callbacks.clear();
+    }
+
+    TextureHandle handle(slot);
+    for (auto& callback : callbacks) {
+        callback(handle);
+    }
+}
+
+} // namespace engine
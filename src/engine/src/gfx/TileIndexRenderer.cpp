@@ -0,0 +1,259 @@
+#include "engine/gfx/TileIndexRenderer.h"
+#include "engine/gfx/Renderer2D.h"
+#include "engine/gfx/Shader.h"
+#include "engine/gfx/Texture2D.h"
+#include "engine/gfx/TileTypeTable.h"
+#include "engine/gfx/VertexArray.h"
+#include "engine/gfx/VertexBuffer.h"
+#include "engine/gfx/GLFunctions.h"
+#include "engine/gfx/GLUtils.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace engine {
+
+static const char* s_vertexShaderSource = R"(
+#version 330 core
+layout(location = 0) in vec2 a_pos;
+
+uniform mat4 u_viewproj;
+
+out vec2 v_world;
+
+void main() {
+    v_world = a_pos;
+    gl_Position = u_viewproj * vec4(a_pos, 0.0, 1.0);
+}
+)";
+
+// Preceded by #version and TileTypeTable::GLSL
+static const char* s_fragmentShaderSource = R"(
+#define MAX_LAYERS 8
+in vec2 v_world;
+
+uniform usampler2DArray u_tiles;
+uniform sampler2D u_tileTypes;
+uniform sampler2D u_atlas;
+uniform int u_tileTypeCount;
+uniform float u_time;
+uniform float u_tileSize;
+uniform int u_layerCount;
+uniform int u_layerSlice[MAX_LAYERS];
+uniform vec2 u_layerOffset[MAX_LAYERS];
+uniform float u_layerOpacity[MAX_LAYERS];
+
+out vec4 FragColor;
+
+void main() {
+    // Gradients of the continuous tile coordinate, taken before any branching
+    // (fract() jumps at tile edges and would pick the smallest mip there).
+    // Layers only differ by a translation, so one pair serves all of them.
+    vec2 gradX = dFdx(v_world) / u_tileSize;
+    vec2 gradY = dFdy(v_world) / u_tileSize;
+
+    ivec2 gridSize = textureSize(u_tiles, 0).xy;
+    vec4 result = vec4(0.0);  // Premultiplied alpha
+
+    for (int i = 0; i < u_layerCount; ++i) {
+        vec2 tile = (v_world - u_layerOffset[i]) / u_tileSize;
+        ivec2 cell = ivec2(floor(tile));
+        if (any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(cell, gridSize))) continue;
+
+        uint index = texelFetch(u_tiles, ivec3(cell, u_layerSlice[i]), 0).r;
+        if (index == 65535u || int(index) >= u_tileTypeCount) continue;
+
+        vec4 rect = TileTypeRect(u_tileTypes, int(index), TilePhase(cell), u_time);
+        if (rect.x < 0.0) continue;
+
+        vec2 span = rect.zw - rect.xy;
+        vec2 uv = rect.xy + fract(tile) * span;
+        vec4 color = textureGrad(u_atlas, uv, gradX * span, gradY * span);
+        float alpha = color.a * u_layerOpacity[i];
+        result = vec4(color.rgb * alpha, alpha) + result * (1.0 - alpha);
+    }
+
+    if (result.a <= 0.0) discard;
+    FragColor = vec4(result.rgb / result.a, result.a);
+}
+)";
+
+// Texture units used while drawing
+static constexpr int TILES_UNIT = 0;
+static constexpr int TILE_TYPES_UNIT = 1;
+static constexpr int ATLAS_UNIT = 2;
+
+TileIndexRenderer::TileIndexRenderer() = default;
+
+TileIndexRenderer::~TileIndexRenderer() {
+    Destroy();
+}
+
+bool TileIndexRenderer::Init(int width, int height, int layerCount) {
+    Destroy();
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if (width <= 0 || height <= 0 || width > maxSize || height > maxSize) {
+        SDL_Log("TileIndexRenderer: %dx%d grid does not fit a texture (max %d)", width, height, maxSize);
+        return false;
+    }
+    if (layerCount < 1 || layerCount > MAX_LAYERS) {
+        SDL_Log("TileIndexRenderer: %d layers not supported (max %d)", layerCount, MAX_LAYERS);
+        return false;
+    }
+
+    std::string fragmentSource = std::string("#version 330 core\n") + TileTypeTable::GLSL + s_fragmentShaderSource;
+    m_shader = std::make_unique<Shader>(s_vertexShaderSource, fragmentSource);
+    if (!m_shader->IsValid()) {
+        SDL_Log("TileIndexRenderer: Failed to create shader");
+        m_shader.reset();
+        return false;
+    }
+    m_shader->Bind();
+    m_shader->SetInt("u_tiles", TILES_UNIT);
+    m_shader->SetInt("u_tileTypes", TILE_TYPES_UNIT);
+    m_shader->SetInt("u_atlas", ATLAS_UNIT);
+    m_shader->Unbind();
+
+    m_width = width;
+    m_height = height;
+    m_layerCount = layerCount;
+
+    // Integer textures can't be filtered, tiles are fetched with texelFetch anyway
+    glGenTextures(1, &m_indexTexture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_indexTexture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+    std::vector<uint16_t> empty(static_cast<size_t>(width) * height * layerCount, EMPTY_TEXEL);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R16UI, width, height, layerCount, 0,
+                 GL_RED_INTEGER, GL_UNSIGNED_SHORT, empty.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // One quad, rewritten every draw with the visible part of the map
+    m_quadVAO = std::make_unique<VertexArray>();
+    m_quadVBO = std::make_unique<VertexBuffer>(nullptr, 4 * sizeof(Vec2), true);
+    m_quadVAO->Bind();
+    m_quadVBO->Bind();
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vec2), nullptr);
+    glEnableVertexAttribArray(0);
+    m_quadVAO->Unbind();
+
+    GL_CHECK_ERROR();
+    return true;
+}
+
+void TileIndexRenderer::Destroy() {
+    if (m_indexTexture != 0) {
+        glDeleteTextures(1, &m_indexTexture);
+        m_indexTexture = 0;
+    }
+    m_quadVBO.reset();
+    m_quadVAO.reset();
+    m_shader.reset();
+    m_width = 0;
+    m_height = 0;
+    m_layerCount = 0;
+}
+
+uint16_t TileIndexRenderer::ToTexel(int32_t tileIndex) {
+    return tileIndex < 0 || tileIndex >= EMPTY_TEXEL ? EMPTY_TEXEL : static_cast<uint16_t>(tileIndex);
+}
+
+void TileIndexRenderer::UploadTiles(int layer, const int32_t* tiles) {
+    if (!IsValid() || layer < 0 || layer >= m_layerCount) return;
+
+    std::vector<uint16_t> texels(static_cast<size_t>(m_width) * m_height);
+    for (size_t i = 0; i < texels.size(); ++i) {
+        texels[i] = ToTexel(tiles[i]);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_indexTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_width, m_height, 1,
+                    GL_RED_INTEGER, GL_UNSIGNED_SHORT, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TileIndexRenderer::UpdateTile(int layer, int x, int y, int32_t tileIndex) {
+    if (!IsValid() || layer < 0 || layer >= m_layerCount ||
+        x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+
+    uint16_t texel = ToTexel(tileIndex);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_indexTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, layer, 1, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_SHORT, &texel);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TileIndexRenderer::Draw(Renderer2D& renderer, const Texture2D& atlas, const TileTypeTable& tileTypes,
+                             const std::vector<LayerDraw>& layers, float tileSize) {
+    if (!IsValid() || !atlas.IsValid() || !tileTypes.IsValid() || tileSize <= 0.0f || layers.empty()) return;
+
+    int layerCount = std::min(static_cast<int>(layers.size()), MAX_LAYERS);
+
+    // Cover the union of all layers, clipped to the screen
+    const Vec4& view = renderer.GetViewBounds();
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < layerCount; ++i) {
+        const Vec2& offset = layers[i].offset;
+        minX = std::min(minX, offset.x);
+        minY = std::min(minY, offset.y);
+        maxX = std::max(maxX, offset.x + m_width * tileSize);
+        maxY = std::max(maxY, offset.y + m_height * tileSize);
+    }
+    minX = std::max(minX, view.x);
+    minY = std::max(minY, view.y);
+    maxX = std::min(maxX, view.z);
+    maxY = std::min(maxY, view.w);
+    if (minX >= maxX || minY >= maxY) return;
+
+    renderer.FlushBatch();
+
+    Vec2 corners[4] = {
+        Vec2(minX, minY), Vec2(maxX, minY), Vec2(maxX, maxY), Vec2(minX, maxY)
+    };
+    m_quadVBO->SetData(corners, sizeof(corners));
+
+    m_shader->Bind();
+    m_shader->SetMat4("u_viewproj", renderer.GetViewProjection());
+    m_shader->SetFloat("u_tileSize", tileSize);
+    m_shader->SetInt("u_tileTypeCount", tileTypes.GetTypeCount());
+    m_shader->SetFloat("u_time", renderer.GetTime());
+    m_shader->SetInt("u_layerCount", layerCount);
+    char name[32];
+    for (int i = 0; i < layerCount; ++i) {
+        snprintf(name, sizeof(name), "u_layerSlice[%d]", i);
+        m_shader->SetInt(name, layers[i].layer);
+        snprintf(name, sizeof(name), "u_layerOffset[%d]", i);
+        m_shader->SetVec2(name, layers[i].offset);
+        snprintf(name, sizeof(name), "u_layerOpacity[%d]", i);
+        m_shader->SetFloat(name, layers[i].opacity);
+    }
+
+    glActiveTexture(GL_TEXTURE0 + TILES_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_indexTexture);
+    tileTypes.Bind(TILE_TYPES_UNIT);
+    atlas.Bind(ATLAS_UNIT);
+
+    m_quadVAO->Bind();
+    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    GL_CHECK_ERROR();
+    m_quadVAO->Unbind();
+
+    glActiveTexture(GL_TEXTURE0 + TILES_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    m_shader->Unbind();
+}
+
+} // namespace engine
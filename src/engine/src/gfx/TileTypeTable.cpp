@@ -0,0 +1,116 @@
+#include "engine/gfx/TileTypeTable.h"
+#include "engine/gfx/GLFunctions.h"
+#include "engine/gfx/GLUtils.h"
+#include <SDL3/SDL_log.h>
+
+namespace engine {
+
+// Texel layout (row 0):
+//   [type]  static uvRect | (-1, -1, -1, -1) hidden |
+//           (-2, first frame texel, frame count, phase spread in seconds) animated
+//   frames: (uvRect), (end time within the cycle, 0, 0, 0) per frame
+const char* TileTypeTable::GLSL = R"(
+uint TilePhase(ivec2 cell) {
+    uint h = uint(cell.x) * 0x8DA6B343u ^ uint(cell.y) * 0xD8163841u;
+    h ^= h >> 15u;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12u;
+    return h & 255u;
+}
+
+// Atlas rect of a tile type at a time; x < 0 for hidden types
+vec4 TileTypeRect(sampler2D table, int type, uint phase, float time) {
+    vec4 entry = texelFetch(table, ivec2(type, 0), 0);
+    if (entry.x > -1.5) return entry;
+
+    int first = int(entry.y);
+    int count = int(entry.z);
+    float cycle = texelFetch(table, ivec2(first + 2 * count - 1, 0), 0).x;
+    float t = mod(time + entry.w * float(phase) / 256.0, cycle);
+    for (int i = 0; i < count - 1; ++i) {
+        if (t < texelFetch(table, ivec2(first + 2 * i + 1, 0), 0).x) {
+            return texelFetch(table, ivec2(first + 2 * i, 0), 0);
+        }
+    }
+    return texelFetch(table, ivec2(first + 2 * count - 2, 0), 0);
+}
+)";
+
+static_assert(TileTypeTable::PHASE_STEPS == 256, "GLSL TilePhase masks with 255");
+
+TileTypeTable::TileTypeTable() = default;
+
+TileTypeTable::~TileTypeTable() {
+    if (m_texture != 0) {
+        glDeleteTextures(1, &m_texture);
+    }
+}
+
+void TileTypeTable::Upload(const std::vector<Entry>& types) {
+    // Types first, so the shader finds type t at texel t
+    std::vector<Vec4> texels;
+    texels.reserve(types.size());
+    for (const Entry& type : types) {
+        texels.push_back(type.visible && type.frames.size() < 2 ? type.uvRect : Vec4(-1.0f, -1.0f, -1.0f, -1.0f));
+    }
+    for (size_t i = 0; i < types.size(); ++i) {
+        const Entry& type = types[i];
+        if (!type.visible || type.frames.size() < 2) continue;
+
+        float cycle = 0.0f;
+        int first = static_cast<int>(texels.size());
+        for (const Frame& frame : type.frames) {
+            cycle += frame.duration > 0.0f ? frame.duration : 0.0f;
+            texels.push_back(frame.uvRect);
+            texels.push_back(Vec4(cycle, 0.0f, 0.0f, 0.0f));
+        }
+        if (cycle <= 0.0f) {
+            // Zero-length cycle: show the first frame
+            texels.resize(first);
+            texels[i] = type.frames[0].uvRect;
+            continue;
+        }
+        texels[i] = Vec4(-2.0f, static_cast<float>(first), static_cast<float>(type.frames.size()),
+                         type.phaseSpread * cycle);
+    }
+
+    // Keep at least one (hidden) entry so the texture is never zero-sized
+    if (texels.empty()) {
+        texels.push_back(Vec4(-1.0f, -1.0f, -1.0f, -1.0f));
+    }
+
+    if (m_texture == 0) {
+        glGenTextures(1, &m_texture);
+        glBindTexture(GL_TEXTURE_2D, m_texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, m_texture);
+    }
+
+    int count = static_cast<int>(texels.size());
+    if (count == m_texelCount) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, count, 1, GL_RGBA, GL_FLOAT, texels.data());
+    } else {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (count > maxSize) {
+            SDL_Log("TileTypeTable: %d entries exceed GL_MAX_TEXTURE_SIZE (%d)", count, maxSize);
+        }
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, count, 1, 0, GL_RGBA, GL_FLOAT, texels.data());
+        m_texelCount = count;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    GL_CHECK_ERROR();
+
+    m_typeCount = static_cast<int>(types.size());
+}
+
+void TileTypeTable::Bind(uint32_t slot) const {
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+} // namespace engine
@@ -1,10 +1,76 @@
 #include "engine/gfx/Tilemap.h"
 #include "engine/gfx/SpriteSheet.h"
 #include "engine/gfx/Renderer2D.h"
+#include "engine/gfx/VertexArray.h"
+#include "engine/gfx/VertexBuffer.h"
+#include "engine/gfx/QuadVertex.h"
+#include "engine/gfx/TileIndexRenderer.h"
+#include "engine/gfx/Texture2D.h"
+#include "engine/gfx/TextureData.h"
+#include "engine/gfx/CookedTexture.h"
+#include "engine/core/ThreadPool.h"
 #include "engine/math/Vec4.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
 
 namespace engine {
 
+// Chunk meshes not drawn for this many Draw calls are freed (rebuilt on demand)
+static constexpr uint64_t CHUNK_MESH_KEEP_FRAMES = 300;
+
+// RaycastBatch: rays per group claimed at a time (enough work to outweigh the hand-off)
+static constexpr size_t RAYS_PER_JOB = 64;
+
+// IndexTexture mode: past this many single-texel updates per frame,
+// re-uploading the whole grid is cheaper
+static constexpr size_t MAX_PENDING_TEXELS = 1024;
+
+// Overviews: atlas pixels averaged per texel, at most this many per side
+static constexpr int LOD_SAMPLES_PER_TEXEL = 8;
+
+// Overviews: side of one atlas page in texels (1 MiB plus mips, 256 chunk slots at one texel per tile)
+static constexpr int LOD_PAGE_SIZE = 512;
+
+// Average RGBA of an atlas region (pixel rows bottom-up), weighted by alpha
+// so transparent pixels don't darken the color. Regions are at least a pixel
+static void AverageAtlasRegion(const uint8_t* pixels, int width, int height,
+                               float u0, float v0, float u1, float v1, uint8_t* out) {
+    int x0 = std::clamp(static_cast<int>(u0 * width), 0, width - 1);
+    int y0 = std::clamp(static_cast<int>(v0 * height), 0, height - 1);
+    int x1 = std::clamp(static_cast<int>(std::ceil(u1 * width)), x0 + 1, width);
+    int y1 = std::clamp(static_cast<int>(std::ceil(v1 * height)), y0 + 1, height);
+    int stepX = std::max(1, (x1 - x0) / LOD_SAMPLES_PER_TEXEL);
+    int stepY = std::max(1, (y1 - y0) / LOD_SAMPLES_PER_TEXEL);
+    
+    uint64_t r = 0, g = 0, b = 0, a = 0, count = 0;
+    for (int y = y0; y < y1; y += stepY) {
+        for (int x = x0; x < x1; x += stepX) {
+            const uint8_t* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            r += pixel[0] * pixel[3];
+            g += pixel[1] * pixel[3];
+            b += pixel[2] * pixel[3];
+            a += pixel[3];
+            ++count;
+        }
+    }
+    if (a == 0) {
+        std::memset(out, 0, 4);
+        return;
+    }
+    out[0] = static_cast<uint8_t>(r / a);
+    out[1] = static_cast<uint8_t>(g / a);
+    out[2] = static_cast<uint8_t>(b / a);
+    out[3] = static_cast<uint8_t>(a / count);
+}
+
 // Create a tilemap with given grid dimensions
 // All tiles are initialized to EMPTY_TILE (-1)
 // tileSize is in world units (typically pixels)
@@ -12,53 +78,359 @@ Tilemap::Tilemap(int width, int height, float tileSize)
     : m_width(width)
     , m_height(height)
     , m_tileSize(tileSize)
-    , m_tiles(width * height, EMPTY_TILE)
+    , m_chunksX((width + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , m_chunksY((height + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , m_chunks(m_chunksX * m_chunksY)
+    , m_colliderChunks(m_chunksX * m_chunksY)
 {
+    m_layers.emplace_back();
+    InitLayerTiles(m_layers[0]);
 }
 
+// Defined here so Chunk's unique_ptrs see complete GL wrapper types
+Tilemap::~Tilemap() = default;
+Tilemap::Tilemap(Tilemap&&) = default;
+Tilemap& Tilemap::operator=(Tilemap&&) = default;
+
 // Set sprite sheet for tile graphics. Does not take ownership.
+// Names mapped earlier are looked up again in the new sheet
 void Tilemap::SetSpriteSheet(const SpriteSheet* spriteSheet) {
     m_spriteSheet = spriteSheet;
+    m_sheetVersion = m_spriteSheet ? m_spriteSheet->GetVersion() : 0;
+    for (size_t i = 0; i < m_tileSprites.size(); ++i) {
+        if (!m_tileSpriteNames[i].empty()) {
+            m_tileSprites[i] = m_spriteSheet ? m_spriteSheet->FindSprite(m_tileSpriteNames[i])
+                                             : INVALID_SPRITE_ID;
+        }
+        ResolveTile(i);
+    }
+    MarkAllChunksDirty();
 }
 
 // Map a tile index to a sprite name in the sprite sheet
 // Example: SetTileSprite(0, "grass") means tile index 0 draws "grass"
-// The mapping vector grows automatically to accommodate new indices
+// The name is resolved to a SpriteId here, so Draw never looks names up
 void Tilemap::SetTileSprite(int32_t tileIndex, const std::string& spriteName) {
     if (tileIndex < 0) return;
     
-    // Grow vector if needed
-    if (static_cast<size_t>(tileIndex) >= m_tileSprites.size()) {
-        m_tileSprites.resize(tileIndex + 1);
+    SpriteId spriteId = m_spriteSheet ? m_spriteSheet->FindSprite(spriteName) : INVALID_SPRITE_ID;
+    SetTileSprite(tileIndex, spriteId);
+    m_tileSpriteNames[tileIndex] = spriteName;
+}
+
+// The mapping vectors grow automatically to accommodate new indices
+void Tilemap::SetTileSprite(int32_t tileIndex, SpriteId spriteId) {
+    if (tileIndex < 0) return;
+    
+    EnsureTileType(tileIndex);
+    m_tileSprites[tileIndex] = spriteId;
+    m_tileSpriteNames[tileIndex].clear();
+    ResolveTile(tileIndex);
+    MarkAllChunksDirty();
+}
+
+SpriteId Tilemap::GetTileSprite(int32_t tileIndex) const {
+    SyncWithSheet();
+    if (tileIndex < 0 || static_cast<size_t>(tileIndex) >= m_tileSprites.size()) {
+        return INVALID_SPRITE_ID;
+    }
+    return m_tileSprites[tileIndex];
+}
+
+// Frames stay sprite names so a sheet reload re-resolves them like sprites
+void Tilemap::SetTileAnimation(int32_t tileIndex, const Animation& animation, float phaseSpread) {
+    if (tileIndex < 0) return;
+    if (tileIndex > TileTypeTable::MAX_ANIMATED_TYPE) {
+        SDL_Log("Tilemap: tile %d can't be animated (max %d)", tileIndex, TileTypeTable::MAX_ANIMATED_TYPE);
+        return;
+    }
+    
+    EnsureTileType(tileIndex);
+    TileAnimation& tileAnimation = m_tileAnimations[tileIndex];
+    tileAnimation.frames = animation.frames;
+    tileAnimation.phaseSpread = std::clamp(phaseSpread, 0.0f, 1.0f);
+    ResolveTile(tileIndex);
+    MarkAllChunksDirty();
+}
+
+void Tilemap::ClearTileAnimation(int32_t tileIndex) {
+    if (tileIndex < 0 || static_cast<size_t>(tileIndex) >= m_tileAnimations.size() ||
+        m_tileAnimations[tileIndex].frames.empty()) {
+        return;
+    }
+    
+    m_tileAnimations[tileIndex] = TileAnimation();
+    ResolveTile(tileIndex);
+    MarkAllChunksDirty();
+}
+
+bool Tilemap::IsTileAnimated(int32_t tileIndex) const {
+    SyncWithSheet();
+    return static_cast<uint32_t>(tileIndex) < m_tileUVs.size() && m_tileUVs[tileIndex].animated;
+}
+
+// The per-type vectors grow together, automatically, to fit new indices
+void Tilemap::EnsureTileType(int32_t tileIndex) {
+    if (static_cast<size_t>(tileIndex) < m_tileSprites.size()) return;
+    
+    m_tileSprites.resize(tileIndex + 1, INVALID_SPRITE_ID);
+    m_tileSpriteNames.resize(tileIndex + 1);
+    m_tileAnimations.resize(tileIndex + 1);
+    m_tileUVs.resize(tileIndex + 1);
+}
+
+// Copy the sprite's (or animation frames') UVs into the table chunk building reads from
+// Animation frames whose sprite is missing are skipped
+void Tilemap::ResolveTile(size_t tileIndex) const {
+    TileUV& tile = m_tileUVs[tileIndex];
+    const TileAnimation& animation = m_tileAnimations[tileIndex];
+    tile.frames.clear();
+    tile.phaseSpread = animation.phaseSpread;
+    
+    if (animation.frames.empty()) {
+        const Sprite* sprite = m_spriteSheet ? m_spriteSheet->GetSprite(m_tileSprites[tileIndex]) : nullptr;
+        tile.visible = sprite != nullptr;
+        tile.uvRect = sprite ? sprite->uvRect : Vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    } else {
+        for (const AnimationFrame& frame : animation.frames) {
+            const Sprite* sprite = m_spriteSheet ? m_spriteSheet->GetSprite(m_spriteSheet->FindSprite(frame.spriteName))
+                                                 : nullptr;
+            if (sprite) {
+                tile.frames.push_back({ sprite->uvRect, frame.duration });
+            }
+        }
+        tile.visible = !tile.frames.empty();
+        tile.uvRect = tile.visible ? tile.frames[0].uvRect : Vec4(0.0f, 0.0f, 1.0f, 1.0f);
     }
+    tile.animated = tile.frames.size() > 1;
+    m_tileTableDirty = true;
+}
+
+// The sheet changed since the table was built (reload, new sprites, new texture):
+// names may map to other IDs now, so resolve everything again
+void Tilemap::SyncWithSheet() const {
+    if (!m_spriteSheet || m_spriteSheet->GetVersion() == m_sheetVersion) return;
+    
+    m_sheetVersion = m_spriteSheet->GetVersion();
+    for (size_t i = 0; i < m_tileSprites.size(); ++i) {
+        if (!m_tileSpriteNames[i].empty()) {
+            m_tileSprites[i] = m_spriteSheet->FindSprite(m_tileSpriteNames[i]);
+        }
+        ResolveTile(i);
+    }
+    MarkAllChunksDirty();
+}
+
+int Tilemap::AddLayer(const Vec2& parallax, float opacity, int zOrder) {
+    if (m_layers.size() >= MAX_LAYERS) {
+        return -1;
+    }
+    
+    Layer layer;
+    InitLayerTiles(layer);
+    layer.parallax = parallax;
+    layer.opacity = opacity;
+    layer.zOrder = zOrder;
+    m_layers.push_back(std::move(layer));
     
-    m_tileSprites[tileIndex] = spriteName;
+    // Chunks of the new layer go after the existing ones, so indices stay valid
+    m_chunks.resize(m_chunks.size() + m_chunksX * m_chunksY);
+    m_indexTilesDirty = true;
+    m_pendingTexels.clear();
+    return static_cast<int>(m_layers.size()) - 1;
 }
 
-void Tilemap::SetTile(int x, int y, int32_t tileIndex) {
-    if (InBounds(x, y)) {
-        m_tiles[Index(x, y)] = tileIndex;
+void Tilemap::SetLayerParallax(int layer, const Vec2& parallax) {
+    if (ValidLayer(layer)) m_layers[layer].parallax = parallax;
+}
+
+void Tilemap::SetLayerOpacity(int layer, float opacity) {
+    if (ValidLayer(layer)) m_layers[layer].opacity = opacity;
+}
+
+void Tilemap::SetLayerZOrder(int layer, int zOrder) {
+    if (ValidLayer(layer)) m_layers[layer].zOrder = zOrder;
+}
+
+Vec2 Tilemap::GetLayerParallax(int layer) const {
+    return ValidLayer(layer) ? m_layers[layer].parallax : Vec2(1.0f, 1.0f);
+}
+
+float Tilemap::GetLayerOpacity(int layer) const {
+    return ValidLayer(layer) ? m_layers[layer].opacity : 0.0f;
+}
+
+int Tilemap::GetLayerZOrder(int layer) const {
+    return ValidLayer(layer) ? m_layers[layer].zOrder : 0;
+}
+
+// Only the chunk containing the tile is rebuilt (and only if the tile changed)
+void Tilemap::SetTile(int layer, int x, int y, int32_t tileIndex) {
+    if (!ValidLayer(layer) || !InBounds(x, y)) return;
+    
+    int chunkX = x / CHUNK_SIZE;
+    int chunkY = y / CHUNK_SIZE;
+    PackedTileChunk& tiles = m_layers[layer].tiles[chunkY * m_chunksX + chunkX];
+    int32_t previous = tiles.Get(x - chunkX * CHUNK_SIZE, y - chunkY * CHUNK_SIZE);
+    if (!tiles.Set(x - chunkX * CHUNK_SIZE, y - chunkY * CHUNK_SIZE, tileIndex)) return;
+    
+    // Merged colliders only change if solidity did
+    if (layer == m_collisionLayer && IsTileSolid(previous) != IsTileSolid(tileIndex)) {
+        m_colliderChunks[chunkY * m_chunksX + chunkX].dirty = true;
+    }
+    Chunk& chunk = m_chunks[ChunkIndex(layer, chunkX, chunkY)];
+    chunk.dirty = true;
+    chunk.lodDirty = true;
+    
+    // IndexTexture mode turns this into a one-texel upload on the next Draw
+    if (m_renderMode == TilemapRenderMode::IndexTexture && !m_indexTilesDirty) {
+        if (m_pendingTexels.size() < MAX_PENDING_TEXELS) {
+            m_pendingTexels.push_back(static_cast<size_t>(layer) * m_width * m_height + Index(x, y));
+        } else {
+            m_indexTilesDirty = true;
+            m_pendingTexels.clear();
+        }
     }
 }
 
-int32_t Tilemap::GetTile(int x, int y) const {
-    if (InBounds(x, y)) {
-        return m_tiles[Index(x, y)];
+int32_t Tilemap::GetTile(int layer, int x, int y) const {
+    if (ValidLayer(layer) && InBounds(x, y)) {
+        int chunkX = x / CHUNK_SIZE;
+        int chunkY = y / CHUNK_SIZE;
+        return m_layers[layer].tiles[chunkY * m_chunksX + chunkX].Get(x - chunkX * CHUNK_SIZE,
+                                                                      y - chunkY * CHUNK_SIZE);
     }
     return EMPTY_TILE;
 }
 
-void Tilemap::Fill(int32_t tileIndex) {
-    std::fill(m_tiles.begin(), m_tiles.end(), tileIndex);
+// Decoded a chunk row at a time; cells outside the map read as EMPTY_TILE
+void Tilemap::GetTileRow(int layer, int x, int y, int count, int32_t* out) const {
+    if (!ValidLayer(layer) || y < 0 || y >= m_height) {
+        std::fill(out, out + count, EMPTY_TILE);
+        return;
+    }
+    
+    int end = x + count;
+    for (; x < end && x < 0; ++x) {
+        *out++ = EMPTY_TILE;
+    }
+    
+    int chunkY = y / CHUNK_SIZE;
+    int localY = y - chunkY * CHUNK_SIZE;
+    int32_t row[PackedTileChunk::SIZE];
+    while (x < end && x < m_width) {
+        int chunkX = x / CHUNK_SIZE;
+        int localX = x - chunkX * CHUNK_SIZE;
+        int span = std::min({ CHUNK_SIZE - localX, end - x, m_width - x });
+        
+        const PackedTileChunk& tiles = m_layers[layer].tiles[chunkY * m_chunksX + chunkX];
+        if (tiles.IsUniform()) {
+            std::fill(out, out + span, tiles.Get(0));
+        } else {
+            tiles.DecodeRow(localY, row);
+            std::copy(row + localX, row + localX + span, out);
+        }
+        out += span;
+        x += span;
+    }
+    
+    for (; x < end; ++x) {
+        *out++ = EMPTY_TILE;
+    }
+}
+
+size_t Tilemap::GetTileMemoryUsage() const {
+    size_t bytes = 0;
+    for (const Layer& layer : m_layers) {
+        for (const PackedTileChunk& tiles : layer.tiles) {
+            bytes += tiles.GetMemoryUsage();
+        }
+    }
+    return bytes;
+}
+
+void Tilemap::InitLayerTiles(Layer& layer) const {
+    layer.tiles.clear();
+    layer.tiles.reserve(m_chunksX * m_chunksY);
+    for (int i = 0; i < m_chunksX * m_chunksY; ++i) {
+        layer.tiles.emplace_back(EMPTY_TILE);
+    }
+}
+
+void Tilemap::Fill(int layer, int32_t tileIndex) {
+    if (!ValidLayer(layer)) return;
+    
+    for (PackedTileChunk& tiles : m_layers[layer].tiles) {
+        tiles.Fill(tileIndex);
+    }
+    for (int cy = 0; cy < m_chunksY; ++cy) {
+        for (int cx = 0; cx < m_chunksX; ++cx) {
+            Chunk& chunk = m_chunks[ChunkIndex(layer, cx, cy)];
+            chunk.dirty = true;
+            chunk.lodDirty = true;
+        }
+    }
+    if (layer == m_collisionLayer) {
+        MarkAllCollidersDirty();
+    }
+    m_indexTilesDirty = true;
+    m_pendingTexels.clear();
+}
+
+void Tilemap::SwapChunk(int layer, int chunkX, int chunkY, PackedTileChunk& tiles) {
+    if (!ValidLayer(layer) || chunkX < 0 || chunkX >= m_chunksX || chunkY < 0 || chunkY >= m_chunksY) return;
+    
+    std::swap(m_layers[layer].tiles[chunkY * m_chunksX + chunkX], tiles);
+    Chunk& chunk = m_chunks[ChunkIndex(layer, chunkX, chunkY)];
+    chunk.dirty = true;
+    chunk.lodDirty = true;
+    if (layer == m_collisionLayer) {
+        m_colliderChunks[chunkY * m_chunksX + chunkX].dirty = true;
+    }
+    // IndexTexture mode uploads the grid once on the next Draw, however many
+    // chunks arrived this frame
+    m_indexTilesDirty = true;
+    m_pendingTexels.clear();
+}
+
+void Tilemap::SetRenderMode(TilemapRenderMode mode) {
+    if (mode == m_renderMode) return;
+    
+    m_renderMode = mode;
+    // Edits made in the other mode were not tracked per texel
+    m_indexTilesDirty = true;
+    m_pendingTexels.clear();
+}
+
+// Slots change size, so every overview is released and re-encoded on demand
+void Tilemap::SetLodResolution(int texelsPerTile) {
+    texelsPerTile = texelsPerTile >= 2 ? 2 : 1;
+    if (texelsPerTile == m_lodResolution) return;
+    
+    m_lodResolution = texelsPerTile;
+    m_lodTileTypeVersion = UINT64_MAX;
+    ReleaseLodSlots();
 }
 
 void Tilemap::Clear() {
-    Fill(EMPTY_TILE);
+    for (int layer = 0; layer < GetLayerCount(); ++layer) {
+        Fill(layer, EMPTY_TILE);
+    }
 }
 
-// Render all tiles using the batch renderer
-// Iterates through grid, looks up sprite for each tile, submits quads
-// Empty tiles (EMPTY_TILE) are skipped
+// Called whenever tile types resolve differently, so meshes built from them
+// (here and through AppendTileQuads) are rebuilt
+void Tilemap::MarkAllChunksDirty() const {
+    ++m_tileTypeVersion;
+    for (Chunk& chunk : m_chunks) {
+        chunk.dirty = true;
+        chunk.lodDirty = true;
+    }
+}
+
+// Render every layer's chunks overlapping the view, back to front
+// Each visible chunk is one DrawMesh call with its cached vertex buffer;
+// parallax and opacity are per-draw uniforms, so they never dirty a chunk
 // offset: world position of the tilemap's bottom-left corner
 void Tilemap::Draw(Renderer2D& renderer, const Vec2& offset) const {
     if (!m_spriteSheet || !m_spriteSheet->IsValid()) {
@@ -68,38 +440,786 @@ void Tilemap::Draw(Renderer2D& renderer, const Vec2& offset) const {
     const Texture2D* texture = m_spriteSheet->GetTexture();
     if (!texture) return;
     
-    Vec2 size(m_tileSize, m_tileSize);
-    Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    SyncWithSheet();
+    const TileTypeTable* tileTypes = GetTileTypeTable();
     
-    // DrawQuad positions are centered, so offset by half tile
-    float halfTile = m_tileSize * 0.5f;
+    // Draw order and per-layer origin (parallax shifts by the camera position)
+    const Vec4& view = renderer.GetViewBounds();
+    Vec2 cameraCenter((view.x + view.z) * 0.5f, (view.y + view.w) * 0.5f);
+    std::vector<int> order(m_layers.size());
+    std::vector<Vec2> offsets(m_layers.size());
+    for (size_t i = 0; i < m_layers.size(); ++i) {
+        const Vec2& parallax = m_layers[i].parallax;
+        order[i] = static_cast<int>(i);
+        offsets[i] = Vec2(offset.x + cameraCenter.x * (1.0f - parallax.x),
+                          offset.y + cameraCenter.y * (1.0f - parallax.y));
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_layers[a].zOrder < m_layers[b].zOrder;
+    });
+    
+    ++m_drawFrame;
+    
+    // Zoomed out (overview textures) or IndexTexture mode: no chunk mesh is
+    // drawn, so meshes built earlier age out and are released
+    if (renderer.GetPixelsPerUnit() < m_lodZoom && DrawLod(renderer, order, offsets)) {
+        ReleaseStaleChunks();
+        return;
+    }
+    
+    if (m_renderMode == TilemapRenderMode::IndexTexture &&
+        DrawIndexTexture(renderer, *texture, *tileTypes, order, offsets)) {
+        ReleaseStaleChunks();
+        return;
+    }
+    
+    for (int layer : order) {
+        float opacity = m_layers[layer].opacity;
+        if (opacity <= 0.0f) continue;
+        
+        const Vec2& layerOffset = offsets[layer];
+        int minX, minY, maxX, maxY;
+        GetVisibleChunks(view, layerOffset, minX, minY, maxX, maxY);
+        Vec4 tint(1.0f, 1.0f, 1.0f, opacity);
+        
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                Chunk& chunk = m_chunks[ChunkIndex(layer, cx, cy)];
+                if (chunk.dirty) {
+                    BuildChunk(renderer, layer, cx, cy);
+                }
+                chunk.lastDrawnFrame = m_drawFrame;
+                
+                if (chunk.indexCount > 0) {
+                    renderer.DrawMesh(*chunk.mesh, chunk.indexCount, *texture, layerOffset, tint, tileTypes);
+                }
+            }
+        }
+    }
+    
+    ReleaseStaleChunks();
+}
+
+// Chunk range covered by the view, in layer-local space (empty when min > max)
+void Tilemap::GetVisibleChunks(const Vec4& view, const Vec2& layerOffset,
+                               int& minX, int& minY, int& maxX, int& maxY) const {
+    float chunkWorldSize = CHUNK_SIZE * m_tileSize;
+    minX = std::max(0, static_cast<int>(std::floor((view.x - layerOffset.x) / chunkWorldSize)));
+    minY = std::max(0, static_cast<int>(std::floor((view.y - layerOffset.y) / chunkWorldSize)));
+    maxX = std::min(m_chunksX - 1, static_cast<int>(std::floor((view.z - layerOffset.x) / chunkWorldSize)));
+    maxY = std::min(m_chunksY - 1, static_cast<int>(std::floor((view.w - layerOffset.y) / chunkWorldSize)));
+}
+
+// Rebuild one chunk's static vertex buffer from the tile grid
+// Vertices are in tilemap-local space, Draw applies the offset on the GPU
+void Tilemap::BuildChunk(Renderer2D& renderer, int layer, int chunkX, int chunkY) const {
+    Chunk& chunk = m_chunks[ChunkIndex(layer, chunkX, chunkY)];
+    chunk.dirty = false;
+    const PackedTileChunk& packed = m_layers[layer].tiles[chunkY * m_chunksX + chunkX];
+    
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    int endX = std::min(startX + CHUNK_SIZE, m_width);
+    int endY = std::min(startY + CHUNK_SIZE, m_height);
+    
+    // Uniform chunks of an undrawn tile (usually all empty) need no decode at all
+    std::vector<QuadVertex> vertices;
+    int32_t uniformTile = packed.Get(0);
+    bool uniformHidden = packed.IsUniform() &&
+        (static_cast<uint32_t>(uniformTile) >= m_tileUVs.size() || !m_tileUVs[uniformTile].visible);
+    if (!uniformHidden) {
+        int32_t tiles[PackedTileChunk::CELLS];
+        packed.Decode(tiles);
+        vertices.reserve(CHUNK_SIZE * CHUNK_SIZE * VERTICES_PER_QUAD);
+        AppendTileQuads(tiles, endX - startX, endY - startY, CHUNK_SIZE,
+                        Vec2(startX * m_tileSize, startY * m_tileSize), vertices, startX, startY);
+    }
+    
+    bool hadMesh = chunk.mesh != nullptr;
+    chunk.indexCount = static_cast<uint32_t>(vertices.size() / VERTICES_PER_QUAD) * INDICES_PER_QUAD;
+    
+    if (vertices.empty()) {
+        chunk.mesh.reset();
+        chunk.vertices.reset();
+        return;
+    }
+    
+    chunk.vertices = std::make_unique<VertexBuffer>(vertices.data(), vertices.size() * sizeof(QuadVertex));
+    chunk.mesh = std::make_unique<VertexArray>();
+    renderer.SetupMesh(*chunk.mesh, *chunk.vertices);
+    
+    if (!hadMesh) {
+        m_meshChunks.push_back(ChunkIndex(layer, chunkX, chunkY));
+    }
+}
+
+void Tilemap::SetTileSolid(int32_t tileIndex, bool solid) {
+    if (tileIndex < 0) return;
     
-    // Iterate all tiles (row by row for cache-friendly access)
-    for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            int32_t tileIndex = m_tiles[Index(x, y)];
+    if (static_cast<size_t>(tileIndex) >= m_tileSolid.size()) {
+        if (!solid) return;
+        m_tileSolid.resize(tileIndex + 1, 0);
+    }
+    if (m_tileSolid[tileIndex] != (solid ? 1 : 0)) {
+        m_tileSolid[tileIndex] = solid ? 1 : 0;
+        MarkAllCollidersDirty();
+    }
+}
+
+void Tilemap::SetTileOpaque(int32_t tileIndex, bool opaque) {
+    if (tileIndex < 0) return;
+    
+    if (static_cast<size_t>(tileIndex) >= m_tileOpaque.size()) {
+        if (!opaque) return;
+        m_tileOpaque.resize(tileIndex + 1, 0);
+    }
+    m_tileOpaque[tileIndex] = opaque ? 1 : 0;
+}
+
+void Tilemap::SetCollisionLayer(int layer) {
+    if (ValidLayer(layer) && layer != m_collisionLayer) {
+        m_collisionLayer = layer;
+        MarkAllCollidersDirty();
+    }
+}
+
+void Tilemap::MarkAllCollidersDirty() {
+    for (ColliderChunk& colliders : m_colliderChunks) {
+        colliders.dirty = true;
+    }
+}
+
+// Merged collider boxes of the chunks under bounds; rebuilds dirty chunks first
+void Tilemap::QueryColliders(const AABB& bounds, std::vector<AABB>& out, const Vec2& offset) const {
+    out.clear();
+    if (m_tileSolid.empty()) return;
+    
+    float chunkWorldSize = CHUNK_SIZE * m_tileSize;
+    int minX = std::max(0, static_cast<int>(std::floor((bounds.min.x - offset.x) / chunkWorldSize)));
+    int minY = std::max(0, static_cast<int>(std::floor((bounds.min.y - offset.y) / chunkWorldSize)));
+    int maxX = std::min(m_chunksX - 1, static_cast<int>(std::floor((bounds.max.x - offset.x) / chunkWorldSize)));
+    int maxY = std::min(m_chunksY - 1, static_cast<int>(std::floor((bounds.max.y - offset.y) / chunkWorldSize)));
+    
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            for (const TileRect& rect : GetChunkColliderRects(cx, cy)) {
+                AABB box = TileRectToAABB(cx, cy, rect, offset);
+                if (box.Intersects(bounds)) {
+                    out.push_back(box);
+                }
+            }
+        }
+    }
+}
+
+void Tilemap::GetColliders(std::vector<AABB>& out, const Vec2& offset) const {
+    out.clear();
+    if (m_tileSolid.empty()) return;
+    
+    for (int cy = 0; cy < m_chunksY; ++cy) {
+        for (int cx = 0; cx < m_chunksX; ++cx) {
+            for (const TileRect& rect : GetChunkColliderRects(cx, cy)) {
+                out.push_back(TileRectToAABB(cx, cy, rect, offset));
+            }
+        }
+    }
+}
+
+const std::vector<Tilemap::TileRect>& Tilemap::GetChunkColliderRects(int chunkX, int chunkY) const {
+    ColliderChunk& colliders = m_colliderChunks[chunkY * m_chunksX + chunkX];
+    if (colliders.dirty) {
+        BuildChunkColliders(chunkX, chunkY);
+    }
+    return colliders.rects;
+}
+
+AABB Tilemap::TileRectToAABB(int chunkX, int chunkY, const TileRect& rect, const Vec2& offset) const {
+    Vec2 min(offset.x + (chunkX * CHUNK_SIZE + rect.x) * m_tileSize,
+             offset.y + (chunkY * CHUNK_SIZE + rect.y) * m_tileSize);
+    return AABB(min, min + Vec2(rect.width * m_tileSize, rect.height * m_tileSize));
+}
+
+// Greedy merge on per-row solid bitmasks (one bit per tile, CHUNK_SIZE == 32):
+// take the lowest run of solid tiles in a row, then grow it upward while the
+// next row has the same run solid, and clear the covered bits
+void Tilemap::BuildChunkColliders(int chunkX, int chunkY) const {
+    ColliderChunk& colliders = m_colliderChunks[chunkY * m_chunksX + chunkX];
+    colliders.dirty = false;
+    colliders.rects.clear();
+    
+    int startX = chunkX * CHUNK_SIZE;
+    int startY = chunkY * CHUNK_SIZE;
+    int columns = std::min(CHUNK_SIZE, m_width - startX);
+    int rows = std::min(CHUNK_SIZE, m_height - startY);
+    
+    uint32_t solid[CHUNK_SIZE] = {};
+    int32_t row[CHUNK_SIZE];
+    for (int y = 0; y < rows; ++y) {
+        GetTileRow(m_collisionLayer, startX, startY + y, columns, row);
+        for (int x = 0; x < columns; ++x) {
+            if (IsTileSolid(row[x])) {
+                solid[y] |= uint32_t(1) << x;
+            }
+        }
+    }
+    
+    for (int y = 0; y < rows; ++y) {
+        while (solid[y] != 0) {
+            int x = std::countr_zero(solid[y]);
+            int width = std::countr_one(solid[y] >> x);
+            uint32_t run = (width == 32 ? ~uint32_t(0) : ((uint32_t(1) << width) - 1)) << x;
+            
+            int height = 1;
+            while (y + height < rows && (solid[y + height] & run) == run) {
+                solid[y + height] &= ~run;
+                ++height;
+            }
+            solid[y] &= ~run;
             
-            // Skip empty tiles
-            if (tileIndex == EMPTY_TILE) continue;
+            colliders.rects.push_back({ static_cast<uint8_t>(x), static_cast<uint8_t>(y),
+                                        static_cast<uint8_t>(width), static_cast<uint8_t>(height) });
+        }
+    }
+}
+
+// Visits only the tile rectangle under bounds; tiles that merely touch an
+// edge of bounds are left out
+void Tilemap::QuerySolidTiles(const AABB& bounds, std::vector<AABB>& out, const Vec2& offset) const {
+    out.clear();
+    if (m_tileSolid.empty()) return;
+    
+    int minX = std::max(0, static_cast<int>(std::floor((bounds.min.x - offset.x) / m_tileSize)));
+    int minY = std::max(0, static_cast<int>(std::floor((bounds.min.y - offset.y) / m_tileSize)));
+    int maxX = std::min(m_width - 1, static_cast<int>(std::ceil((bounds.max.x - offset.x) / m_tileSize)) - 1);
+    int maxY = std::min(m_height - 1, static_cast<int>(std::ceil((bounds.max.y - offset.y) / m_tileSize)) - 1);
+    
+    int32_t row[CHUNK_SIZE];
+    Vec2 tileSize(m_tileSize, m_tileSize);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int startX = minX; startX <= maxX; startX += CHUNK_SIZE) {
+            int count = std::min(CHUNK_SIZE, maxX - startX + 1);
+            GetTileRow(m_collisionLayer, startX, y, count, row);
+            for (int i = 0; i < count; ++i) {
+                if (!IsTileSolid(row[i])) continue;
+                
+                Vec2 tileMin(offset.x + (startX + i) * m_tileSize, offset.y + y * m_tileSize);
+                out.push_back(AABB(tileMin, tileMin + tileSize));
+            }
+        }
+    }
+}
+
+MoveResult Tilemap::MoveAndSlide(const AABB& box, const Vec2& delta, const Vec2& offset) const {
+    QueryColliders(Collision::GetSweptBounds(box, delta), m_collisionScratch, offset);
+    return Collision::MoveAndSlide(box, delta, m_collisionScratch);
+}
+
+// Amanatides-Woo traversal in grid units: the ray is first clipped to the map
+// rectangle, then steps to whichever cell border (x or y) it reaches next
+TileRaycastHit Tilemap::Raycast(const Vec2& origin, const Vec2& direction, float maxDistance,
+                                const Vec2& offset) const {
+    TileRaycastHit result;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length <= 0.0f || maxDistance <= 0.0f || m_tileSolid.empty()) {
+        return result;
+    }
+    
+    Vec2 dir(direction.x / length, direction.y / length);
+    Vec2 start((origin.x - offset.x) / m_tileSize, (origin.y - offset.y) / m_tileSize);
+    float tEnd = maxDistance / m_tileSize;
+    
+    // Clip against the map (slab test), remembering which face the ray enters through
+    float tStart = 0.0f;
+    Vec2 entryNormal(0.0f, 0.0f);
+    float bounds[2][2] = { { 0.0f, static_cast<float>(m_width) }, { 0.0f, static_cast<float>(m_height) } };
+    float startAxis[2] = { start.x, start.y };
+    float dirAxis[2] = { dir.x, dir.y };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (dirAxis[axis] == 0.0f) {
+            if (startAxis[axis] < bounds[axis][0] || startAxis[axis] >= bounds[axis][1]) return result;
+            continue;
+        }
+        float t0 = (bounds[axis][0] - startAxis[axis]) / dirAxis[axis];
+        float t1 = (bounds[axis][1] - startAxis[axis]) / dirAxis[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tStart) {
+            tStart = t0;
+            entryNormal = axis == 0 ? Vec2(dirAxis[0] > 0.0f ? -1.0f : 1.0f, 0.0f)
+                                    : Vec2(0.0f, dirAxis[1] > 0.0f ? -1.0f : 1.0f);
+        }
+        tEnd = std::min(tEnd, t1);
+    }
+    if (tStart > tEnd) {
+        return result;
+    }
+    
+    Vec2 entry(start.x + dir.x * tStart, start.y + dir.y * tStart);
+    int x = std::clamp(static_cast<int>(std::floor(entry.x)), 0, m_width - 1);
+    int y = std::clamp(static_cast<int>(std::floor(entry.y)), 0, m_height - 1);
+    
+    int stepX = dir.x > 0.0f ? 1 : -1;
+    int stepY = dir.y > 0.0f ? 1 : -1;
+    const float infinity = std::numeric_limits<float>::infinity();
+    float tDeltaX = dir.x != 0.0f ? std::abs(1.0f / dir.x) : infinity;
+    float tDeltaY = dir.y != 0.0f ? std::abs(1.0f / dir.y) : infinity;
+    float tMaxX = dir.x > 0.0f ? tStart + (x + 1 - entry.x) / dir.x
+                : dir.x < 0.0f ? tStart + (entry.x - x) / -dir.x : infinity;
+    float tMaxY = dir.y > 0.0f ? tStart + (y + 1 - entry.y) / dir.y
+                : dir.y < 0.0f ? tStart + (entry.y - y) / -dir.y : infinity;
+    
+    float t = tStart;
+    Vec2 normal = entryNormal;
+    while (true) {
+        int32_t tile = GetTile(m_collisionLayer, x, y);
+        if (IsTileSolid(tile)) {
+            float distance = t * m_tileSize;
+            result.hit = true;
+            result.cellX = x;
+            result.cellY = y;
+            result.tile = tile;
+            result.normal = normal;
+            result.distance = distance;
+            result.point = Vec2(origin.x + dir.x * distance, origin.y + dir.y * distance);
+            return result;
+        }
+        
+        if (tMaxX < tMaxY) {
+            t = tMaxX;
+            tMaxX += tDeltaX;
+            x += stepX;
+            normal = Vec2(static_cast<float>(-stepX), 0.0f);
+        } else {
+            t = tMaxY;
+            tMaxY += tDeltaY;
+            y += stepY;
+            normal = Vec2(0.0f, static_cast<float>(-stepY));
+        }
+        
+        if (t > tEnd || x < 0 || x >= m_width || y < 0 || y >= m_height) {
+            return result;
+        }
+    }
+}
+
+bool Tilemap::LineOfSight(const Vec2& from, const Vec2& to, const Vec2& offset) const {
+    Vec2 delta(to.x - from.x, to.y - from.y);
+    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (distance <= 0.0f) {
+        return !IsSolidAt(static_cast<int>(std::floor((from.x - offset.x) / m_tileSize)),
+                          static_cast<int>(std::floor((from.y - offset.y) / m_tileSize)));
+    }
+    return !Raycast(from, delta, distance, offset).hit;
+}
+
+// Rays are independent and Raycast only reads the map, so groups of rays
+// run on workers without locking
+void Tilemap::RaycastBatch(const std::vector<TileRay>& rays, std::vector<TileRaycastHit>& hits,
+                           ThreadPool& pool, const Vec2& offset) const {
+    hits.assign(rays.size(), TileRaycastHit());
+    if (rays.empty()) return;
+    
+    // Groups are claimed from a shared counter by the pool jobs and by the
+    // caller. Only claimed groups touch the rays, so a job that starts after
+    // the batch returned finds nothing left and exits. The caller waits on
+    // this batch alone, never on the rest of the pool's queue.
+    struct Batch {
+        const Tilemap* map;
+        const TileRay* rays;
+        TileRaycastHit* hits;
+        size_t count;
+        size_t groups;
+        Vec2 offset;
+        std::atomic<size_t> nextGroup{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t finishedGroups = 0;
+        
+        // Cast claimed groups until none are left
+        void Run() {
+            size_t finished = 0;
+            for (size_t group; (group = nextGroup.fetch_add(1)) < groups; ++finished) {
+                size_t first = group * RAYS_PER_JOB;
+                size_t last = std::min(first + RAYS_PER_JOB, count);
+                for (size_t i = first; i < last; ++i) {
+                    hits[i] = map->Raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance, offset);
+                }
+            }
+            if (finished == 0) return;
+            std::lock_guard<std::mutex> lock(mutex);
+            finishedGroups += finished;
+            if (finishedGroups == groups) {
+                done.notify_all();
+            }
+        }
+    };
+    
+    auto batch = std::make_shared<Batch>();
+    batch->map = this;
+    batch->rays = rays.data();
+    batch->hits = hits.data();
+    batch->count = rays.size();
+    batch->groups = (rays.size() + RAYS_PER_JOB - 1) / RAYS_PER_JOB;
+    batch->offset = offset;
+    
+    // The caller takes a share too, so one job fewer than groups is enough
+    size_t jobs = std::min(batch->groups - 1, pool.GetThreadCount());
+    for (size_t j = 0; j < jobs; ++j) {
+        pool.Submit([batch] { batch->Run(); });
+    }
+    batch->Run();
+    
+    // Called from a pool worker this cannot deadlock: every group left is
+    // already running on some thread
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done.wait(lock, [&batch] { return batch->finishedGroups == batch->groups; });
+}
+
+// Quads for a block of tiles, rows are stride tiles apart in memory
+// Tile types are read from the resolved UV table, so no sprite lookups happen here.
+// Animated tiles get tile-corner UVs and a packed type/phase instead of a texture
+// slot; the vertex shader swaps in the current frame
+void Tilemap::AppendTileQuads(const int32_t* tiles, int columns, int rows, int stride,
+                              const Vec2& origin, std::vector<QuadVertex>& vertices,
+                              int firstCellX, int firstCellY) const {
+    SyncWithSheet();
+    Vec4 white(1.0f, 1.0f, 1.0f, 1.0f);
+    
+    for (int y = 0; y < rows; ++y) {
+        const int32_t* row = tiles + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < columns; ++x) {
+            int32_t tileIndex = row[x];
             
-            // Skip if no sprite mapped for this tile index
-            if (tileIndex < 0 || static_cast<size_t>(tileIndex) >= m_tileSprites.size()) continue;
+            // One unsigned compare skips EMPTY_TILE and unmapped indices
+            if (static_cast<uint32_t>(tileIndex) >= m_tileUVs.size()) continue;
             
-            const std::string& spriteName = m_tileSprites[tileIndex];
-            if (spriteName.empty()) continue;
+            const TileUV& tile = m_tileUVs[tileIndex];
+            if (!tile.visible) continue;
             
-            const Sprite* sprite = m_spriteSheet->GetSprite(spriteName);
-            if (!sprite) continue;
+            float x0 = origin.x + x * m_tileSize;
+            float y0 = origin.y + y * m_tileSize;
+            float x1 = x0 + m_tileSize;
+            float y1 = y0 + m_tileSize;
             
-            // Calculate world position (center of tile)
-            Vec2 pos(
-                offset.x + x * m_tileSize + halfTile,
-                offset.y + y * m_tileSize + halfTile
-            );
+            if (tile.animated) {
+                uint32_t phase = TileTypeTable::TilePhase(firstCellX + x, firstCellY + y);
+                float texIndex = TileTypeTable::EncodeAnimatedTexIndex(tileIndex, phase);
+                vertices.push_back({ Vec2(x0, y0), Vec2(0.0f, 0.0f), white, texIndex });
+                vertices.push_back({ Vec2(x1, y0), Vec2(1.0f, 0.0f), white, texIndex });
+                vertices.push_back({ Vec2(x1, y1), Vec2(1.0f, 1.0f), white, texIndex });
+                vertices.push_back({ Vec2(x0, y1), Vec2(0.0f, 1.0f), white, texIndex });
+                continue;
+            }
+            const Vec4& uv = tile.uvRect;
             
-            // Submit to batch renderer (actual draw happens in EndFrame)
-            renderer.DrawQuad(pos, size, *texture, sprite->uvRect, white);
+            // Same corner order as Renderer2D batches: BL, BR, TR, TL
+            vertices.push_back({ Vec2(x0, y0), Vec2(uv.x, uv.y), white, 0.0f });
+            vertices.push_back({ Vec2(x1, y0), Vec2(uv.z, uv.y), white, 0.0f });
+            vertices.push_back({ Vec2(x1, y1), Vec2(uv.z, uv.w), white, 0.0f });
+            vertices.push_back({ Vec2(x0, y1), Vec2(uv.x, uv.w), white, 0.0f });
+        }
+    }
+}
+
+uint64_t Tilemap::GetTileTypeVersion() const {
+    SyncWithSheet();
+    return m_tileTypeVersion;
+}
+
+// One upload per tile type change, shared by chunk meshes and the index texture
+const TileTypeTable* Tilemap::GetTileTypeTable() const {
+    SyncWithSheet();
+    if (!m_tileTable) {
+        m_tileTable = std::make_unique<TileTypeTable>();
+        m_tileTableDirty = true;
+    }
+    if (m_tileTableDirty) {
+        std::vector<TileTypeTable::Entry> entries(m_tileUVs.size());
+        for (size_t i = 0; i < m_tileUVs.size(); ++i) {
+            const TileUV& tile = m_tileUVs[i];
+            entries[i].visible = tile.visible;
+            entries[i].uvRect = tile.uvRect;
+            if (tile.animated) {
+                entries[i].frames = tile.frames;
+                entries[i].phaseSpread = tile.phaseSpread;
+            }
+        }
+        m_tileTable->Upload(entries);
+        m_tileTableDirty = false;
+    }
+    return m_tileTable.get();
+}
+
+// Bring the index texture up to date and draw all layers as one quad
+// Returns false if the GPU path is unavailable (Draw then uses chunks)
+bool Tilemap::DrawIndexTexture(Renderer2D& renderer, const Texture2D& texture, const TileTypeTable& tileTypes,
+                               const std::vector<int>& order, const std::vector<Vec2>& offsets) const {
+    int layerCount = GetLayerCount();
+    if (!m_indexRenderer ||
+        (m_indexRenderer->IsValid() && m_indexRenderer->GetLayerCount() != layerCount)) {
+        m_indexRenderer = std::make_unique<TileIndexRenderer>();
+        m_indexRenderer->Init(m_width, m_height, layerCount);
+        m_indexTilesDirty = true;
+    }
+    if (!m_indexRenderer->IsValid()) {
+        return false;
+    }
+    
+    if (m_indexTilesDirty) {
+        std::vector<int32_t> grid(static_cast<size_t>(m_width) * m_height);
+        for (int layer = 0; layer < layerCount; ++layer) {
+            for (int y = 0; y < m_height; ++y) {
+                GetTileRow(layer, 0, y, m_width, &grid[static_cast<size_t>(y) * m_width]);
+            }
+            m_indexRenderer->UploadTiles(layer, grid.data());
+        }
+        m_indexTilesDirty = false;
+    } else {
+        size_t layerCells = static_cast<size_t>(m_width) * m_height;
+        for (size_t texel : m_pendingTexels) {
+            int layer = static_cast<int>(texel / layerCells);
+            int cell = static_cast<int>(texel % layerCells);
+            int x = cell % m_width;
+            int y = cell / m_width;
+            m_indexRenderer->UpdateTile(layer, x, y, GetTile(layer, x, y));
+        }
+    }
+    m_pendingTexels.clear();
+    
+    std::vector<TileIndexRenderer::LayerDraw> layers;
+    layers.reserve(order.size());
+    for (int layer : order) {
+        if (m_layers[layer].opacity > 0.0f) {
+            layers.push_back({ layer, offsets[layer], m_layers[layer].opacity });
+        }
+    }
+    m_indexRenderer->Draw(renderer, texture, tileTypes, layers, m_tileSize);
+    return true;
+}
+
+// Overview path: every visible chunk is one quad textured from its atlas slot
+// Returns false if overviews can't be used (Draw then draws tiles)
+bool Tilemap::DrawLod(Renderer2D& renderer, const std::vector<int>& order, const std::vector<Vec2>& offsets) const {
+    // Tile types changed: new texels for every type (MarkAllChunksDirty
+    // already flagged every slot)
+    if (m_lodTileTypeVersion != m_tileTypeVersion) {
+        m_lodTileTypeVersion = m_tileTypeVersion;
+        const TextureData* pixels = m_spriteSheet->GetPixels();
+        m_lodUnavailable = !pixels || !pixels->IsValid();
+        if (m_lodUnavailable) {
+            SDL_Log("Tilemap: sprite sheet has no CPU-side pixels (load it with keepPixels), overview disabled");
+        } else {
+            BuildLodTileTexels(*pixels);
+        }
+    }
+    if (m_lodUnavailable) {
+        return false;
+    }
+    
+    const Vec4& view = renderer.GetViewBounds();
+    float chunkWorldSize = CHUNK_SIZE * m_tileSize;
+    int slotSide = CHUNK_SIZE * m_lodResolution;
+    int slotsPerRow = LOD_PAGE_SIZE / slotSide;
+    int slotsPerPage = slotsPerRow * slotsPerRow;
+    float slotUV = static_cast<float>(slotSide) / LOD_PAGE_SIZE;
+    
+    for (int layer : order) {
+        float opacity = m_layers[layer].opacity;
+        if (opacity <= 0.0f) continue;
+        
+        const Vec2& layerOffset = offsets[layer];
+        int minX, minY, maxX, maxY;
+        GetVisibleChunks(view, layerOffset, minX, minY, maxX, maxY);
+        Vec4 tint(1.0f, 1.0f, 1.0f, opacity);
+        
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                // Uniform chunks of an undrawn tile (usually all empty) need no slot
+                const PackedTileChunk& packed = m_layers[layer].tiles[cy * m_chunksX + cx];
+                int32_t uniformTile = packed.Get(0);
+                if (packed.IsUniform() &&
+                    (static_cast<uint32_t>(uniformTile) >= m_tileUVs.size() || !m_tileUVs[uniformTile].visible)) {
+                    continue;
+                }
+                
+                int chunkIndex = ChunkIndex(layer, cx, cy);
+                Chunk& chunk = m_chunks[chunkIndex];
+                if (chunk.lodSlot < 0) {
+                    chunk.lodSlot = AllocateLodSlot();
+                    if (chunk.lodSlot < 0) return false;
+                    chunk.lodDirty = true;
+                    m_lodChunks.push_back(chunkIndex);
+                }
+                if (chunk.lodDirty) {
+                    EncodeLodSlot(layer, cx, cy, chunk.lodSlot);
+                    chunk.lodDirty = false;
+                }
+                chunk.lodLastDrawnFrame = m_drawFrame;
+                
+                int local = chunk.lodSlot % slotsPerPage;
+                float u = (local % slotsPerRow) * slotUV;
+                float v = (local / slotsPerRow) * slotUV;
+                Vec2 center(layerOffset.x + (cx + 0.5f) * chunkWorldSize,
+                            layerOffset.y + (cy + 0.5f) * chunkWorldSize);
+                renderer.DrawQuad(center, Vec2(chunkWorldSize, chunkWorldSize),
+                                  *m_lodPages[chunk.lodSlot / slotsPerPage],
+                                  Vec4(u, v, u + slotUV, v + slotUV), tint);
+            }
+        }
+    }
+    return true;
+}
+
+// Average every tile type's sprite (first frame if animated) from the
+// sheet's CPU-side pixels, once per tile type change
+void Tilemap::BuildLodTileTexels(const TextureData& pixels) const {
+    const uint8_t* atlas = pixels.GetLevelData(0);
+    int texels = m_lodResolution;
+    size_t tileBytes = static_cast<size_t>(texels) * texels * 4;
+    m_lodTileTexels.assign(m_tileUVs.size() * tileBytes, 0);
+    for (size_t i = 0; i < m_tileUVs.size(); ++i) {
+        const TileUV& tile = m_tileUVs[i];
+        if (!tile.visible) continue;
+        
+        const Vec4& uv = tile.uvRect;
+        float texelU = (uv.z - uv.x) / texels;
+        float texelV = (uv.w - uv.y) / texels;
+        uint8_t* out = &m_lodTileTexels[i * tileBytes];
+        for (int ty = 0; ty < texels; ++ty) {
+            for (int tx = 0; tx < texels; ++tx, out += 4) {
+                AverageAtlasRegion(atlas, pixels.width, pixels.height,
+                                   uv.x + tx * texelU, uv.y + ty * texelV,
+                                   uv.x + (tx + 1) * texelU, uv.y + (ty + 1) * texelV, out);
+            }
+        }
+    }
+}
+
+// Take a free slot, adding an atlas page when none is left
+// Returns -1 if the page texture couldn't be created
+int Tilemap::AllocateLodSlot() const {
+    if (m_lodFreeSlots.empty()) {
+        int slotSide = CHUNK_SIZE * m_lodResolution;
+        int slotsPerRow = LOD_PAGE_SIZE / slotSide;
+        int slotsPerPage = slotsPerRow * slotsPerRow;
+        
+        // Mips stop at one texel per slot, so no level blends neighbouring chunks
+        auto page = std::make_unique<Texture2D>(nullptr, LOD_PAGE_SIZE, LOD_PAGE_SIZE,
+                                                TextureFilter::NearestMipmap);
+        if (!page->IsValid()) return -1;
+        page->SetMaxMipLevel(std::countr_zero(static_cast<unsigned>(slotSide)));
+        
+        int first = static_cast<int>(m_lodPages.size()) * slotsPerPage;
+        m_lodPages.push_back(std::move(page));
+        for (int i = slotsPerPage - 1; i >= 0; --i) {
+            m_lodFreeSlots.push_back(first + i);
+        }
+    }
+    int slot = m_lodFreeSlots.back();
+    m_lodFreeSlots.pop_back();
+    return slot;
+}
+
+// Write one chunk's tiles into its slot, level 0 from the tile texels and
+// every smaller level box-filtered on the CPU, each uploaded in place
+void Tilemap::EncodeLodSlot(int layer, int chunkX, int chunkY, int slot) const {
+    int texels = m_lodResolution;
+    int slotSide = CHUNK_SIZE * texels;
+    int levels = std::countr_zero(static_cast<unsigned>(slotSide)) + 1;
+    size_t tileRowBytes = static_cast<size_t>(texels) * 4;
+    size_t tileBytes = tileRowBytes * texels;
+    size_t tileTypes = m_lodTileTexels.size() / tileBytes;
+    size_t rowBytes = static_cast<size_t>(slotSide) * 4;
+    
+    size_t chainBytes = 0;
+    for (int level = 0; level < levels; ++level) {
+        chainBytes += static_cast<size_t>(slotSide >> level) * (slotSide >> level) * 4;
+    }
+    m_lodPixels.resize(chainBytes);
+    
+    // Cells past the map edge read as EMPTY_TILE and stay transparent
+    int32_t tiles[CHUNK_SIZE];
+    for (int y = 0; y < CHUNK_SIZE; ++y) {
+        GetTileRow(layer, chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE + y, CHUNK_SIZE, tiles);
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            int32_t tileIndex = tiles[x];
+            const uint8_t* source = static_cast<uint32_t>(tileIndex) < tileTypes
+                                  ? &m_lodTileTexels[tileIndex * tileBytes] : nullptr;
+            for (int ty = 0; ty < texels; ++ty) {
+                uint8_t* target = &m_lodPixels[(static_cast<size_t>(y) * texels + ty) * rowBytes + x * tileRowBytes];
+                if (source) {
+                    std::memcpy(target, source + ty * tileRowBytes, tileRowBytes);
+                } else {
+                    std::memset(target, 0, tileRowBytes);
+                }
+            }
+        }
+    }
+    
+    int slotsPerRow = LOD_PAGE_SIZE / slotSide;
+    int local = slot % (slotsPerRow * slotsPerRow);
+    int slotX = (local % slotsPerRow) * slotSide;
+    int slotY = (local / slotsPerRow) * slotSide;
+    Texture2D& page = *m_lodPages[slot / (slotsPerRow * slotsPerRow)];
+    
+    uint8_t* level = m_lodPixels.data();
+    for (int l = 0; l < levels; ++l) {
+        int side = slotSide >> l;
+        if (l > 0) {
+            uint8_t* next = level + static_cast<size_t>(side) * 2 * side * 2 * 4;
+            CookedTexture::Downsample(level, side * 2, side * 2, next, side, side);
+            level = next;
         }
+        page.UpdateLevel(l, slotX >> l, slotY >> l, side, side, level);
+    }
+}
+
+// Drop every slot and page (resolution changed or no chunk holds a slot)
+void Tilemap::ReleaseLodSlots() const {
+    for (int chunkIndex : m_lodChunks) {
+        m_chunks[chunkIndex].lodSlot = -1;
+        m_chunks[chunkIndex].lodDirty = true;
+    }
+    m_lodChunks.clear();
+    m_lodFreeSlots.clear();
+    m_lodPages.clear();
+}
+
+// Free GPU buffers of chunks that scrolled out of view a while ago,
+// so panning across a huge map does not keep every chunk resident
+void Tilemap::ReleaseStaleChunks() const {
+    for (size_t i = 0; i < m_meshChunks.size();) {
+        Chunk& chunk = m_chunks[m_meshChunks[i]];
+        bool stale = m_drawFrame - chunk.lastDrawnFrame > CHUNK_MESH_KEEP_FRAMES;
+        if (chunk.mesh && !stale) {
+            ++i;
+            continue;
+        }
+        
+        if (chunk.mesh) {
+            chunk.mesh.reset();
+            chunk.vertices.reset();
+            chunk.indexCount = 0;
+            chunk.dirty = true;
+        }
+        m_meshChunks[i] = m_meshChunks.back();
+        m_meshChunks.pop_back();
+    }
+    
+    // Overview slots age the same way; pages go once no chunk uses them
+    for (size_t i = 0; i < m_lodChunks.size();) {
+        Chunk& chunk = m_chunks[m_lodChunks[i]];
+        if (m_drawFrame - chunk.lodLastDrawnFrame <= CHUNK_MESH_KEEP_FRAMES) {
+            ++i;
+            continue;
+        }
+        m_lodFreeSlots.push_back(chunk.lodSlot);
+        chunk.lodSlot = -1;
+        chunk.lodDirty = true;
+        m_lodChunks[i] = m_lodChunks.back();
+        m_lodChunks.pop_back();
+    }
+    if (m_lodChunks.empty() && !m_lodPages.empty()) {
+        ReleaseLodSlots();
     }
 }
 
@@ -0,0 +1,257 @@
+#include "engine/platform/MappedFile.h"
+#include <SDL3/SDL_log.h>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace engine {
+
+MappedFile::MappedFile(const std::string& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(other.m_data)
+    , m_size(other.m_size)
+    , m_writable(other.m_writable)
+#ifdef _WIN32
+    , m_fileHandle(other.m_fileHandle)
+    , m_mappingHandle(other.m_mappingHandle)
+#endif
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_writable = false;
+#ifdef _WIN32
+    other.m_fileHandle = nullptr;
+    other.m_mappingHandle = nullptr;
+#endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_writable = other.m_writable;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_writable = false;
+#ifdef _WIN32
+        m_fileHandle = other.m_fileHandle;
+        m_mappingHandle = other.m_mappingHandle;
+        other.m_fileHandle = nullptr;
+        other.m_mappingHandle = nullptr;
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SDL_Log("MappedFile: Failed to open '%s'", path.c_str());
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        SDL_Log("MappedFile: '%s' is empty or unreadable", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        SDL_Log("MappedFile: Failed to map '%s'", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        SDL_Log("MappedFile: Failed to map view of '%s'", path.c_str());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+bool MappedFile::OpenWritable(const std::string& path, size_t minSize) {
+    Close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SDL_Log("MappedFile: Failed to open '%s' for writing", path.c_str());
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        SDL_Log("MappedFile: '%s' is unreadable", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+    size_t mappedSize = static_cast<size_t>(size.QuadPart);
+    if (mappedSize < minSize || mappedSize == 0) {
+        mappedSize = minSize > 0 ? minSize : 1;
+    }
+
+    // A mapping larger than the file extends it
+    LARGE_INTEGER mappingSize;
+    mappingSize.QuadPart = static_cast<LONGLONG>(mappedSize);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                        mappingSize.HighPart, mappingSize.LowPart, nullptr);
+    if (!mapping) {
+        SDL_Log("MappedFile: Failed to map '%s'", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!view) {
+        SDL_Log("MappedFile: Failed to map view of '%s'", path.c_str());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = mappedSize;
+    m_writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (!m_data || !m_writable) return false;
+    return FlushViewOfFile(m_data, 0) && FlushFileBuffers(static_cast<HANDLE>(m_fileHandle));
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_writable = false;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SDL_Log("MappedFile: Failed to open '%s'", path.c_str());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        SDL_Log("MappedFile: '%s' is empty or unreadable", path.c_str());
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps its own reference to the file
+    if (view == MAP_FAILED) {
+        SDL_Log("MappedFile: Failed to map '%s'", path.c_str());
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+bool MappedFile::OpenWritable(const std::string& path, size_t minSize) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        SDL_Log("MappedFile: Failed to open '%s' for writing", path.c_str());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        SDL_Log("MappedFile: '%s' is unreadable", path.c_str());
+        close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size < minSize || size == 0) {
+        size = minSize > 0 ? minSize : 1;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            SDL_Log("MappedFile: Failed to grow '%s' to %zu bytes", path.c_str(), size);
+            close(fd);
+            return false;
+        }
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        SDL_Log("MappedFile: Failed to map '%s'", path.c_str());
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = size;
+    m_writable = true;
+    return true;
+}
+
+bool MappedFile::Flush() {
+    if (!m_data || !m_writable) return false;
+    return msync(const_cast<uint8_t*>(m_data), m_size, MS_SYNC) == 0;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_writable = false;
+}
+
+#endif
+
+} // namespace engine
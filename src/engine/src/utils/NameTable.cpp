@@ -0,0 +1,154 @@
+#include "engine/utils/NameTable.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+// Average names per bucket; larger buckets shrink the seed table but make
+// displacement search slower
+constexpr size_t NAMES_PER_BUCKET = 4;
+
+// Give up on a bucket after this many seeds (never reached in practice)
+constexpr uint32_t MAX_SEED_ATTEMPTS = 1u << 24;
+
+// Pending names are scanned linearly, rebuild once there are more of them
+// than this (or than names already in the table)
+constexpr size_t MIN_PENDING_BEFORE_REBUILD = 16;
+
+constexpr uint64_t GOLDEN_RATIO_64 = 0x9E3779B97F4A7C15ull;
+
+const std::string s_emptyName;
+
+// FNV-1a barely changes its high bits between similar names ("run_1", "run_2"),
+// so mix (MixHash spreads the seeded hash over all bits) before picking a bucket
+size_t BucketOf(uint64_t hash, size_t bucketCount) {
+    return static_cast<size_t>((MixHash(hash) >> 32) % bucketCount);
+}
+
+size_t SlotOf(uint64_t hash, uint32_t seed, size_t slotCount) {
+    return static_cast<size_t>(MixHash(hash + seed * GOLDEN_RATIO_64) % slotCount);
+}
+
+} // namespace
+
+uint32_t NameTable::Add(std::string_view name) {
+    uint64_t hash = HashString(name);
+    uint32_t existing = Find(hash);
+    if (existing != NOT_FOUND) {
+        if (m_names[existing] != name) {
+            SDL_Log("NameTable: Hash collision between '%s' and '%.*s'",
+                    m_names[existing].c_str(), static_cast<int>(name.size()), name.data());
+            return NOT_FOUND;
+        }
+        return existing;
+    }
+
+    uint32_t index = static_cast<uint32_t>(m_names.size());
+    m_names.emplace_back(name);
+    m_hashes.push_back(hash);
+
+    // Keep the linear part short: rebuild whenever it outgrows the table
+    size_t pending = m_names.size() - m_builtCount;
+    if (pending > std::max(MIN_PENDING_BEFORE_REBUILD, m_builtCount)) {
+        Build();
+    }
+    return index;
+}
+
+bool NameTable::Build() {
+    if (IsBuilt()) return true;
+
+    size_t count = m_names.size();
+    size_t bucketCount = std::max<size_t>(1, (count + NAMES_PER_BUCKET - 1) / NAMES_PER_BUCKET);
+
+    // Compress: group names by bucket
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+    for (uint32_t i = 0; i < count; ++i) {
+        buckets[BucketOf(m_hashes[i], bucketCount)].push_back(i);
+    }
+
+    // Largest buckets first, while most slots are still free
+    std::vector<uint32_t> order(bucketCount);
+    for (uint32_t b = 0; b < bucketCount; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<uint32_t> seeds(bucketCount, 0);
+    std::vector<uint32_t> slots(count, NOT_FOUND);
+    std::vector<size_t> candidate;
+
+    // Displace: find a seed per bucket that lands all its names on free, distinct slots
+    for (uint32_t b : order) {
+        const std::vector<uint32_t>& bucket = buckets[b];
+        if (bucket.empty()) break;
+
+        bool placed = false;
+        for (uint32_t seed = 0; seed < MAX_SEED_ATTEMPTS && !placed; ++seed) {
+            candidate.clear();
+            placed = true;
+            for (uint32_t index : bucket) {
+                size_t slot = SlotOf(m_hashes[index], seed, count);
+                if (slots[slot] != NOT_FOUND ||
+                    std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                    placed = false;
+                    break;
+                }
+                candidate.push_back(slot);
+            }
+            if (placed) {
+                seeds[b] = seed;
+                for (size_t i = 0; i < bucket.size(); ++i) {
+                    slots[candidate[i]] = bucket[i];
+                }
+            }
+        }
+
+        if (!placed) {
+            SDL_Log("NameTable: Failed to build perfect hash for %zu names", count);
+            return false;
+        }
+    }
+
+    m_seeds = std::move(seeds);
+    m_slots = std::move(slots);
+    m_builtCount = count;
+    return true;
+}
+
+uint32_t NameTable::Find(uint64_t nameHash) const {
+    uint32_t index = FindBuilt(nameHash);
+    return index != NOT_FOUND ? index : FindPending(nameHash);
+}
+
+uint32_t NameTable::FindBuilt(uint64_t nameHash) const {
+    if (m_builtCount == 0) return NOT_FOUND;
+
+    uint32_t seed = m_seeds[BucketOf(nameHash, m_seeds.size())];
+    uint32_t index = m_slots[SlotOf(nameHash, seed, m_slots.size())];
+    // Names outside the set still land on some slot, the hash check rejects them
+    return m_hashes[index] == nameHash ? index : NOT_FOUND;
+}
+
+uint32_t NameTable::FindPending(uint64_t nameHash) const {
+    for (size_t i = m_builtCount; i < m_hashes.size(); ++i) {
+        if (m_hashes[i] == nameHash) return static_cast<uint32_t>(i);
+    }
+    return NOT_FOUND;
+}
+
+const std::string& NameTable::GetName(uint32_t index) const {
+    return index < m_names.size() ? m_names[index] : s_emptyName;
+}
+
+void NameTable::Clear() {
+    m_names.clear();
+    m_hashes.clear();
+    m_seeds.clear();
+    m_slots.clear();
+    m_builtCount = 0;
+}
+
+} // namespace engine
@@ -0,0 +1,186 @@
+#include "engine/utils/Noise.h"
+#include <algorithm>
+#include <bit>
+
+namespace engine {
+
+namespace {
+
+constexpr float SIMPLEX_F2 = 0.36602540378f;    // (sqrt(3) - 1) / 2: skews onto the triangle grid
+constexpr float SIMPLEX_G2 = 0.21132486540f;    // (3 - sqrt(3)) / 6: unskews back
+constexpr float SIMPLEX_SCALE = 40.0f;          // Brings the corner sum to about [-1, 1]
+
+// Decorrelates the octaves of one seed
+constexpr uint32_t OCTAVE_SEED_STEP = 0x9E3779B9u;
+
+// Integer hash of a grid corner. Multiplies and shifts only, so a block of
+// corners is hashed in SIMD registers
+inline uint32_t HashCorner(int32_t x, int32_t y, uint32_t seed) {
+    uint32_t h = seed ^ static_cast<uint32_t>(x) * 0x27D4EB2Du ^ static_cast<uint32_t>(y) * 0x165667B1u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+// Top 24 bits of a hash as a float in [-1, 1)
+inline float HashToFloat(uint32_t h) {
+    return static_cast<float>(static_cast<int32_t>(h >> 8)) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+// floor() as a compare and a conversion (no libm call, vectorizes)
+inline int32_t FastFloor(float value) {
+    int32_t truncated = static_cast<int32_t>(value);
+    return truncated - static_cast<int32_t>(value < static_cast<float>(truncated));
+}
+
+// Flip the sign of value where bit is set (bit must be 0 or 1)
+inline float FlipSign(float value, uint32_t bit) {
+    return std::bit_cast<float>(std::bit_cast<uint32_t>(value) ^ (bit << 31));
+}
+
+inline float ValueLane(float x, float y, uint32_t seed) {
+    int32_t ix = FastFloor(x);
+    int32_t iy = FastFloor(y);
+    float fx = x - static_cast<float>(ix);
+    float fy = y - static_cast<float>(iy);
+    float u = fx * fx * (3.0f - 2.0f * fx);
+    float v = fy * fy * (3.0f - 2.0f * fy);
+
+    float a = HashToFloat(HashCorner(ix, iy, seed));
+    float b = HashToFloat(HashCorner(ix + 1, iy, seed));
+    float c = HashToFloat(HashCorner(ix, iy + 1, seed));
+    float d = HashToFloat(HashCorner(ix + 1, iy + 1, seed));
+    float bottom = a + (b - a) * u;
+    float top = c + (d - c) * u;
+    return bottom + (top - bottom) * v;
+}
+
+// One of 8 gradients picked by hash bits, dotted with (x, y). Selects are
+// written as bit operations: branches would keep the loop from vectorizing
+inline float SimplexCorner(uint32_t h, float x, float y) {
+    float t = 0.5f - x * x - y * y;
+    t = std::bit_cast<float>(std::bit_cast<uint32_t>(t) & (0u - static_cast<uint32_t>(t > 0.0f)));
+    t *= t;
+
+    uint32_t swap = (std::bit_cast<uint32_t>(x) ^ std::bit_cast<uint32_t>(y)) & (0u - ((h >> 2) & 1));
+    float u = std::bit_cast<float>(std::bit_cast<uint32_t>(x) ^ swap);
+    float v = std::bit_cast<float>(std::bit_cast<uint32_t>(y) ^ swap);
+    float gradient = FlipSign(u, h & 1) + FlipSign(2.0f * v, (h >> 1) & 1);
+    return t * t * gradient;
+}
+
+inline float SimplexLane(float x, float y, uint32_t seed) {
+    float skew = (x + y) * SIMPLEX_F2;
+    int32_t i = FastFloor(x + skew);
+    int32_t j = FastFloor(y + skew);
+    float unskew = static_cast<float>(i + j) * SIMPLEX_G2;
+    float x0 = x - (static_cast<float>(i) - unskew);
+    float y0 = y - (static_cast<float>(j) - unskew);
+
+    // Lower or upper triangle of the skewed cell
+    int32_t i1 = static_cast<int32_t>(x0 > y0);
+    int32_t j1 = 1 - i1;
+    float x1 = x0 - static_cast<float>(i1) + SIMPLEX_G2;
+    float y1 = y0 - static_cast<float>(j1) + SIMPLEX_G2;
+    float x2 = x0 - 1.0f + 2.0f * SIMPLEX_G2;
+    float y2 = y0 - 1.0f + 2.0f * SIMPLEX_G2;
+
+    return SIMPLEX_SCALE * (SimplexCorner(HashCorner(i, j, seed), x0, y0) +
+                            SimplexCorner(HashCorner(i + i1, j + j1, seed), x1, y1) +
+                            SimplexCorner(HashCorner(i + 1, j + 1, seed), x2, y2));
+}
+
+template <float (*Lane)(float, float, uint32_t)>
+float SampleFractal(const NoiseSettings& settings, float x, float y) {
+    float sum = 0.0f;
+    float amplitude = 1.0f;
+    float amplitudeSum = 0.0f;
+    float frequency = settings.frequency;
+    uint32_t seed = settings.seed;
+    for (int octave = 0; octave < std::max(settings.octaves, 1); ++octave) {
+        sum += amplitude * Lane(x * frequency, y * frequency, seed);
+        amplitudeSum += amplitude;
+        amplitude *= settings.gain;
+        frequency *= settings.lacunarity;
+        seed += OCTAVE_SEED_STEP;
+    }
+    return sum * (1.0f / amplitudeSum);
+}
+
+// Same arithmetic as SampleFractal, a block of NOISE_LANES samples at a
+// time; the fixed-count lane loops are what the compiler vectorizes
+template <float (*Lane)(float, float, uint32_t)>
+void FillFractal(const NoiseSettings& settings, float x, float y, int width, int height, float* out) {
+    float laneX[NOISE_LANES];
+    float laneY[NOISE_LANES];
+    float values[NOISE_LANES];
+
+    for (int row = 0; row < height; ++row) {
+        float* rowOut = out + static_cast<size_t>(row) * width;
+        std::fill(rowOut, rowOut + width, 0.0f);
+
+        float sampleY = y + static_cast<float>(row);
+        float amplitude = 1.0f;
+        float amplitudeSum = 0.0f;
+        float frequency = settings.frequency;
+        uint32_t seed = settings.seed;
+        for (int octave = 0; octave < std::max(settings.octaves, 1); ++octave) {
+            for (int first = 0; first < width; first += NOISE_LANES) {
+                for (int i = 0; i < NOISE_LANES; ++i) {
+                    laneX[i] = (x + static_cast<float>(first + i)) * frequency;
+                    laneY[i] = sampleY * frequency;
+                }
+                for (int i = 0; i < NOISE_LANES; ++i) {
+                    values[i] = Lane(laneX[i], laneY[i], seed);
+                }
+
+                // The last block of a row may be partial
+                int count = std::min(NOISE_LANES, width - first);
+                for (int i = 0; i < count; ++i) {
+                    rowOut[first + i] += amplitude * values[i];
+                }
+            }
+            amplitudeSum += amplitude;
+            amplitude *= settings.gain;
+            frequency *= settings.lacunarity;
+            seed += OCTAVE_SEED_STEP;
+        }
+
+        float scale = 1.0f / amplitudeSum;
+        for (int i = 0; i < width; ++i) {
+            rowOut[i] *= scale;
+        }
+    }
+}
+
+} // namespace
+
+float ValueNoise(float x, float y, uint32_t seed) {
+    return ValueLane(x, y, seed);
+}
+
+float SimplexNoise(float x, float y, uint32_t seed) {
+    return SimplexLane(x, y, seed);
+}
+
+float SampleNoise(const NoiseSettings& settings, float x, float y) {
+    if (settings.type == NoiseType::Value) {
+        return SampleFractal<ValueLane>(settings, x, y);
+    }
+    return SampleFractal<SimplexLane>(settings, x, y);
+}
+
+void FillNoise(const NoiseSettings& settings, float x, float y, int width, int height, float* out) {
+    if (width <= 0 || height <= 0) return;
+
+    if (settings.type == NoiseType::Value) {
+        FillFractal<ValueLane>(settings, x, y, width, height, out);
+    } else {
+        FillFractal<SimplexLane>(settings, x, y, width, height, out);
+    }
+}
+
+} // namespace engine
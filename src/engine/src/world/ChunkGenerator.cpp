@@ -0,0 +1,198 @@
+#include "engine/world/ChunkGenerator.h"
+#include "engine/gfx/Tilemap.h"
+#include "engine/core/ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace engine {
+
+// Hand-off point between generation workers and the main thread
+struct ChunkGenerator::ResultQueue {
+    struct Result {
+        int layer = 0;
+        int chunkX = 0;
+        int chunkY = 0;
+        PackedTileChunk tiles;
+    };
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::deque<Result> results;
+    size_t building = 0;        // Queued jobs of the current generation not yet finished
+    uint64_t generation = 0;    // Bumped by Cancel() so stale jobs skip their work
+};
+
+ChunkGenerator::ChunkGenerator(uint64_t seed)
+    : m_seed(seed)
+    , m_passes(std::make_shared<const PassList>())
+    , m_results(std::make_shared<ResultQueue>())
+{
+}
+
+ChunkGenerator::~ChunkGenerator() {
+    Cancel();
+    // Private pool joins here; cancelled jobs return without building
+    m_ownedPool.reset();
+}
+
+// Copy on write: queued jobs hold on to the list they were queued with
+void ChunkGenerator::AddPass(Pass pass) {
+    auto passes = std::make_shared<PassList>(*m_passes);
+    passes->push_back(std::move(pass));
+    m_passes = std::move(passes);
+}
+
+void ChunkGenerator::ClearPasses() {
+    m_passes = std::make_shared<const PassList>();
+}
+
+ThreadPool& ChunkGenerator::GetThreadPool() {
+    if (m_threadPool) {
+        return *m_threadPool;
+    }
+    if (!m_ownedPool) {
+        m_ownedPool = std::make_unique<ThreadPool>();
+    }
+    return *m_ownedPool;
+}
+
+// Nearest chunks are queued first, so the area around the player fills in
+// before the rest of the map
+void ChunkGenerator::Generate(const Tilemap& map, int layer, int focusChunkX, int focusChunkY) {
+    std::vector<uint64_t> chunks;
+    chunks.reserve(static_cast<size_t>(map.GetChunksX()) * map.GetChunksY());
+    for (int cy = 0; cy < map.GetChunksY(); ++cy) {
+        for (int cx = 0; cx < map.GetChunksX(); ++cx) {
+            chunks.push_back(ChunkKey(cx, cy));
+        }
+    }
+    auto distance = [focusChunkX, focusChunkY](uint64_t key) {
+        int dx = ChunkKeyX(key) - focusChunkX;
+        int dy = ChunkKeyY(key) - focusChunkY;
+        return dx * dx + dy * dy;
+    };
+    std::stable_sort(chunks.begin(), chunks.end(), [&distance](uint64_t a, uint64_t b) {
+        return distance(a) < distance(b);
+    });
+
+    for (uint64_t key : chunks) {
+        QueueChunk(map, layer, ChunkKeyX(key), ChunkKeyY(key));
+    }
+}
+
+// The job only captures shared state and values, never the generator or the map
+void ChunkGenerator::QueueChunk(const Tilemap& map, int layer, int chunkX, int chunkY) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_results->mutex);
+        generation = m_results->generation;
+        m_results->building++;
+    }
+
+    std::shared_ptr<ResultQueue> queue = m_results;
+    std::shared_ptr<const PassList> passes = m_passes;
+    uint64_t seed = m_seed;
+    int width = map.GetWidth();
+    int height = map.GetHeight();
+    GetThreadPool().Submit([queue, passes, seed, layer, chunkX, chunkY, width, height, generation]() {
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            if (queue->generation != generation) return;  // Cancelled before it started
+        }
+
+        int32_t tiles[CHUNK_TILES];
+        float field[CHUNK_TILES];
+        RunPasses(*passes, seed, chunkX, chunkY, tiles, field);
+
+        // Cells past the map edge stay empty, whatever the passes wrote
+        int columns = std::clamp(width - chunkX * CHUNK_SIZE, 0, CHUNK_SIZE);
+        int rows = std::clamp(height - chunkY * CHUNK_SIZE, 0, CHUNK_SIZE);
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            int firstEmpty = y < rows ? columns : 0;
+            std::fill(tiles + y * CHUNK_SIZE + firstEmpty, tiles + (y + 1) * CHUNK_SIZE, Tilemap::EMPTY_TILE);
+        }
+
+        ResultQueue::Result result;
+        result.layer = layer;
+        result.chunkX = chunkX;
+        result.chunkY = chunkY;
+        result.tiles.Encode(tiles);
+
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->generation != generation) return;  // Cancelled while building
+        queue->results.push_back(std::move(result));
+        if (--queue->building == 0) {
+            queue->idle.notify_all();
+        }
+    });
+}
+
+// One chunk per lock, so workers are never held up for longer than a pop
+int ChunkGenerator::Publish(Tilemap& map, int maxChunks) {
+    int published = 0;
+    while (published < maxChunks) {
+        ResultQueue::Result result;
+        {
+            std::lock_guard<std::mutex> lock(m_results->mutex);
+            if (m_results->results.empty()) break;
+            result = std::move(m_results->results.front());
+            m_results->results.pop_front();
+        }
+
+        if (result.layer < 0 || result.layer >= map.GetLayerCount() || result.chunkX < 0 ||
+            result.chunkY < 0 || result.chunkX >= map.GetChunksX() || result.chunkY >= map.GetChunksY()) {
+            continue;
+        }
+        map.SwapChunk(result.layer, result.chunkX, result.chunkY, result.tiles);
+        published++;
+    }
+    return published;
+}
+
+void ChunkGenerator::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(m_results->mutex);
+        m_results->generation++;
+        m_results->building = 0;
+        m_results->results.clear();
+    }
+    m_results->idle.notify_all();
+}
+
+void ChunkGenerator::Wait() {
+    std::unique_lock<std::mutex> lock(m_results->mutex);
+    m_results->idle.wait(lock, [this] { return m_results->building == 0; });
+}
+
+size_t ChunkGenerator::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_results->mutex);
+    return m_results->building + m_results->results.size();
+}
+
+void ChunkGenerator::GenerateChunk(int chunkX, int chunkY, int32_t* tiles) const {
+    float field[CHUNK_TILES];
+    RunPasses(*m_passes, m_seed, chunkX, chunkY, tiles, field);
+}
+
+void ChunkGenerator::RunPasses(const PassList& passes, uint64_t worldSeed, int chunkX, int chunkY,
+                               int32_t* tiles, float* field) {
+    std::fill(tiles, tiles + CHUNK_TILES, Tilemap::EMPTY_TILE);
+    std::fill(field, field + CHUNK_TILES, 0.0f);
+
+    ChunkGenContext context;
+    context.chunkX = chunkX;
+    context.chunkY = chunkY;
+    context.originX = chunkX * CHUNK_SIZE;
+    context.originY = chunkY * CHUNK_SIZE;
+    context.seed = ChunkSeed(worldSeed, chunkX, chunkY);
+    context.tiles = tiles;
+    context.field = field;
+    context.randomState = context.seed;
+    for (const Pass& pass : passes) {
+        pass(context);
+    }
+}
+
+} // namespace engine
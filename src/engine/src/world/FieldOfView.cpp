@@ -0,0 +1,214 @@
+#include "engine/world/FieldOfView.h"
+#include "engine/gfx/Tilemap.h"
+#include "engine/gfx/Renderer2D.h"
+#include "engine/gfx/Texture2D.h"
+#include <SDL3/SDL_opengl.h>
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+
+// Maps (column, row) of octant 0 to grid offsets for each of the 8 octants
+constexpr int OCTANT_XX[8] = { 1, 0, 0, -1, -1, 0, 0, 1 };
+constexpr int OCTANT_XY[8] = { 0, 1, -1, 0, 0, -1, 1, 0 };
+constexpr int OCTANT_YX[8] = { 0, 1, 1, 0, 0, -1, -1, 0 };
+constexpr int OCTANT_YY[8] = { 1, 0, 0, 1, -1, 0, 0, -1 };
+
+uint8_t ToAlpha(float shade) {
+    return static_cast<uint8_t>(std::clamp(shade, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+FieldOfView::FieldOfView() = default;
+FieldOfView::~FieldOfView() = default;
+
+void FieldOfView::SetViewer(int x, int y, int radius) {
+    radius = std::max(0, radius);
+    if (x == m_viewerX && y == m_viewerY && radius == m_radius) return;
+
+    m_viewerX = x;
+    m_viewerY = y;
+    m_radius = radius;
+    m_dirty = true;
+}
+
+bool FieldOfView::Update(const Tilemap& map) {
+    if (map.GetWidth() != m_width || map.GetHeight() != m_height) {
+        Resize(map.GetWidth(), map.GetHeight());
+    }
+    if (!m_dirty) return false;
+    m_dirty = false;
+
+    // Old view: clear only what was set (the view's area, not the map's)
+    for (int cell : m_visibleCells) {
+        m_visible[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+    }
+    m_visibleCells.clear();
+    MarkViewStale();
+    if (!InBounds(m_viewerX, m_viewerY)) return true;
+
+    MarkVisible(m_viewerX, m_viewerY);
+    for (int octant = 0; octant < 8; ++octant) {
+        CastOctant(map, 1, 1.0f, 0.0f,
+                   OCTANT_XX[octant], OCTANT_XY[octant], OCTANT_YX[octant], OCTANT_YY[octant]);
+    }
+    MarkViewStale();
+    return true;
+}
+
+void FieldOfView::OnTileChanged(int x, int y) {
+    if (IsVisible(x, y)) {
+        m_dirty = true;
+    }
+}
+
+void FieldOfView::ClearExplored() {
+    std::fill(m_explored.begin(), m_explored.end(), 0);
+    for (int cell : m_visibleCells) {
+        m_explored[cell >> 6] |= uint64_t(1) << (cell & 63);
+    }
+    MarkStale(0, 0, m_width - 1, m_height - 1);
+}
+
+void FieldOfView::SetShade(float unexplored, float explored) {
+    m_unexploredAlpha = ToAlpha(unexplored);
+    m_exploredAlpha = ToAlpha(explored);
+    MarkStale(0, 0, m_width - 1, m_height - 1);
+}
+
+void FieldOfView::Draw(Renderer2D& renderer, const Tilemap& map, const Vec2& offset) {
+    if (m_width == 0 || m_height == 0 || m_textureTooLarge) return;
+
+    if (!m_texture || m_texture->GetWidth() != m_width || m_texture->GetHeight() != m_height) {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (m_width > maxSize || m_height > maxSize) {
+            SDL_Log("FieldOfView: %dx%d map exceeds GL_MAX_TEXTURE_SIZE (%d)", m_width, m_height, maxSize);
+            m_textureTooLarge = true;
+            return;
+        }
+        // Created fully stale; the upload below fills it
+        m_pixels.assign(static_cast<size_t>(m_width) * m_height * 4, 0);
+        m_texture = std::make_unique<Texture2D>(m_pixels.data(), m_width, m_height, TextureFilter::Nearest);
+        MarkStale(0, 0, m_width - 1, m_height - 1);
+    }
+
+    if (m_staleMinX <= m_staleMaxX && m_staleMinY <= m_staleMaxY) {
+        int width = m_staleMaxX - m_staleMinX + 1;
+        int height = m_staleMaxY - m_staleMinY + 1;
+        m_pixels.resize(static_cast<size_t>(width) * height * 4);
+
+        uint8_t* texel = m_pixels.data();
+        for (int y = m_staleMinY; y <= m_staleMaxY; ++y) {
+            for (int x = m_staleMinX; x <= m_staleMaxX; ++x, texel += 4) {
+                int cell = y * m_width + x;
+                texel[0] = texel[1] = texel[2] = 0;
+                texel[3] = TestBit(m_visible, cell) ? 0
+                         : TestBit(m_explored, cell) ? m_exploredAlpha : m_unexploredAlpha;
+            }
+        }
+        m_texture->Update(m_staleMinX, m_staleMinY, width, height, m_pixels.data());
+        m_staleMinX = m_staleMinY = 0;
+        m_staleMaxX = m_staleMaxY = -1;
+    }
+
+    float tileSize = map.GetTileSize();
+    Vec2 size(m_width * tileSize, m_height * tileSize);
+    renderer.DrawQuad(offset + size * 0.5f, size, *m_texture);
+}
+
+void FieldOfView::Resize(int width, int height) {
+    m_width = width;
+    m_height = height;
+    m_textureTooLarge = false;
+    size_t words = (static_cast<size_t>(width) * height + 63) / 64;
+    m_visible.assign(words, 0);
+    m_explored.assign(words, 0);
+    m_visibleCells.clear();
+    m_dirty = true;
+    MarkStale(0, 0, width - 1, height - 1);
+}
+
+void FieldOfView::MarkVisible(int x, int y) {
+    int cell = y * m_width + x;
+    uint64_t bit = uint64_t(1) << (cell & 63);
+    if (m_visible[cell >> 6] & bit) return;  // Octant edges overlap
+
+    m_visible[cell >> 6] |= bit;
+    m_explored[cell >> 6] |= bit;
+    m_visibleCells.push_back(cell);
+}
+
+void FieldOfView::MarkStale(int minX, int minY, int maxX, int maxY) {
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, m_width - 1);
+    maxY = std::min(maxY, m_height - 1);
+    if (minX > maxX || minY > maxY) return;
+
+    if (m_staleMinX > m_staleMaxX) {
+        m_staleMinX = minX;
+        m_staleMinY = minY;
+        m_staleMaxX = maxX;
+        m_staleMaxY = maxY;
+        return;
+    }
+    m_staleMinX = std::min(m_staleMinX, minX);
+    m_staleMinY = std::min(m_staleMinY, minY);
+    m_staleMaxX = std::max(m_staleMaxX, maxX);
+    m_staleMaxY = std::max(m_staleMaxY, maxY);
+}
+
+// Everything the current view can touch lies in the radius square
+void FieldOfView::MarkViewStale() {
+    MarkStale(m_viewerX - m_radius, m_viewerY - m_radius, m_viewerX + m_radius, m_viewerY + m_radius);
+}
+
+// Recursive shadowcasting (Bergstrom) for one octant: scans rows outward
+// from the viewer between two slopes. An opaque run narrows the scan for the
+// rows behind it; the part beside it continues in a recursive call
+void FieldOfView::CastOctant(const Tilemap& map, int row, float startSlope, float endSlope,
+                             int xx, int xy, int yx, int yy) {
+    if (startSlope < endSlope) return;
+
+    int radiusSquared = m_radius * m_radius;
+    float nextStartSlope = startSlope;
+    for (int distance = row; distance <= m_radius; ++distance) {
+        bool blocked = false;
+        int dy = -distance;
+        for (int dx = -distance; dx <= 0; ++dx) {
+            float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            int x = m_viewerX + dx * xx + dy * xy;
+            int y = m_viewerY + dx * yx + dy * yy;
+            bool inBounds = InBounds(x, y);
+            if (inBounds && dx * dx + dy * dy <= radiusSquared) {
+                MarkVisible(x, y);
+            }
+
+            // The map edge blocks sight like a wall
+            bool opaque = !inBounds || map.IsOpaqueAt(x, y);
+            if (blocked) {
+                if (opaque) {
+                    nextStartSlope = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                startSlope = nextStartSlope;
+            } else if (opaque && distance < m_radius) {
+                blocked = true;
+                CastOctant(map, distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+                nextStartSlope = rightSlope;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+} // namespace engine
@@ -0,0 +1,228 @@
+#include "engine/world/FlowField.h"
+#include "engine/gfx/Tilemap.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace engine {
+
+void FlowField::Build(const Tilemap& map, const GridPoint& goal) {
+    m_width = map.GetWidth();
+    m_height = map.GetHeight();
+    m_goal = goal;
+    m_cost.assign(static_cast<size_t>(m_width) * m_height, UNREACHABLE);
+    m_direction.assign(m_cost.size(), NO_DIRECTION);
+
+    std::vector<OpenEntry> open;
+    std::vector<int> changed;
+    if (PathGrid::IsWalkable(map, goal.x, goal.y)) {
+        int goalCell = goal.y * m_width + goal.x;
+        m_cost[goalCell] = 0;
+        open.push_back({ 0, goalCell });
+        Propagate(map, open, changed);
+    }
+
+    for (int cell = 0; cell < static_cast<int>(m_cost.size()); ++cell) {
+        UpdateDirection(map, cell);
+    }
+}
+
+// Costs can rise for cells whose route ran through (x, y) or cut past it
+// diagonally, and fall anywhere if (x, y) opened up. The first are found by
+// following direction arrows backwards from (x, y) and its neighbors; they
+// are reset and re-seeded from the cells around them, and one Dijkstra pass
+// then settles both kinds of change.
+void FlowField::OnTileChanged(const Tilemap& map, int x, int y) {
+    if (!IsValid() || !InBounds(x, y)) return;
+
+    // Invalidate the roots and every cell that routes into them
+    std::vector<int> affected;
+    for (int i = -1; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+        int rx = i < 0 ? x : x + PathGrid::NEIGHBOR_DX[i];
+        int ry = i < 0 ? y : y + PathGrid::NEIGHBOR_DY[i];
+        if (!InBounds(rx, ry)) continue;
+
+        int root = ry * m_width + rx;
+        if (m_cost[root] == UNREACHABLE && m_direction[root] == NO_DIRECTION && i >= 0) continue;
+        m_cost[root] = UNREACHABLE;
+        m_direction[root] = NO_DIRECTION;
+        affected.push_back(root);
+    }
+    for (size_t next = 0; next < affected.size(); ++next) {
+        int cx = affected[next] % m_width;
+        int cy = affected[next] / m_width;
+        for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+            int nx = cx + PathGrid::NEIGHBOR_DX[i];
+            int ny = cy + PathGrid::NEIGHBOR_DY[i];
+            if (!InBounds(nx, ny)) continue;
+
+            // Does the neighbor step into this cell?
+            int neighbor = ny * m_width + nx;
+            uint8_t dir = m_direction[neighbor];
+            if (dir == NO_DIRECTION ||
+                nx + PathGrid::NEIGHBOR_DX[dir] != cx || ny + PathGrid::NEIGHBOR_DY[dir] != cy) {
+                continue;
+            }
+            m_cost[neighbor] = UNREACHABLE;
+            m_direction[neighbor] = NO_DIRECTION;
+            affected.push_back(neighbor);
+        }
+    }
+
+    // Re-seed from intact neighbors (or the goal itself)
+    std::vector<OpenEntry> open;
+    for (int cell : affected) {
+        int cx = cell % m_width;
+        int cy = cell / m_width;
+        if (!PathGrid::IsWalkable(map, cx, cy)) continue;
+
+        uint32_t best = UNREACHABLE;
+        if (cx == m_goal.x && cy == m_goal.y) {
+            best = 0;
+        } else {
+            for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+                int dx = PathGrid::NEIGHBOR_DX[i];
+                int dy = PathGrid::NEIGHBOR_DY[i];
+                if (!PathGrid::CanStep(map, cx, cy, dx, dy)) continue;
+
+                uint32_t neighborCost = m_cost[(cy + dy) * m_width + cx + dx];
+                if (neighborCost != UNREACHABLE) {
+                    best = std::min(best, neighborCost + PathGrid::StepCost(dx, dy));
+                }
+            }
+        }
+        if (best != UNREACHABLE) {
+            m_cost[cell] = best;
+            open.push_back({ best, cell });
+        }
+    }
+    std::make_heap(open.begin(), open.end(), std::greater<OpenEntry>());
+
+    std::vector<int> changed;
+    Propagate(map, open, changed);
+
+    // Directions depend on neighbor costs, so refresh around every touched cell
+    changed.insert(changed.end(), affected.begin(), affected.end());
+    for (int cell : changed) {
+        int cx = cell % m_width;
+        int cy = cell / m_width;
+        UpdateDirection(map, cell);
+        for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+            int nx = cx + PathGrid::NEIGHBOR_DX[i];
+            int ny = cy + PathGrid::NEIGHBOR_DY[i];
+            if (InBounds(nx, ny)) {
+                UpdateDirection(map, ny * m_width + nx);
+            }
+        }
+    }
+}
+
+uint32_t FlowField::GetCost(int x, int y) const {
+    return IsValid() && InBounds(x, y) ? m_cost[y * m_width + x] : UNREACHABLE;
+}
+
+Vec2 FlowField::GetDirection(int x, int y) const {
+    if (!IsValid() || !InBounds(x, y)) return Vec2(0.0f, 0.0f);
+
+    uint8_t dir = m_direction[y * m_width + x];
+    if (dir == NO_DIRECTION) return Vec2(0.0f, 0.0f);
+
+    float dx = static_cast<float>(PathGrid::NEIGHBOR_DX[dir]);
+    float dy = static_cast<float>(PathGrid::NEIGHBOR_DY[dir]);
+    float invLength = 1.0f / std::sqrt(dx * dx + dy * dy);
+    return Vec2(dx * invLength, dy * invLength);
+}
+
+bool FlowField::GetNextCell(int x, int y, GridPoint& next) const {
+    if (!IsValid() || !InBounds(x, y)) return false;
+
+    uint8_t dir = m_direction[y * m_width + x];
+    if (dir == NO_DIRECTION) return false;
+
+    next.x = x + PathGrid::NEIGHBOR_DX[dir];
+    next.y = y + PathGrid::NEIGHBOR_DY[dir];
+    return true;
+}
+
+// Dijkstra relaxation from the open list (a min-heap); every cell whose cost
+// drops is appended to changed
+void FlowField::Propagate(const Tilemap& map, std::vector<OpenEntry>& open, std::vector<int>& changed) {
+    std::greater<OpenEntry> compare;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        OpenEntry entry = open.back();
+        open.pop_back();
+        if (entry.first > m_cost[entry.second]) continue;  // Stale entry
+
+        int x = entry.second % m_width;
+        int y = entry.second / m_width;
+        for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+            int dx = PathGrid::NEIGHBOR_DX[i];
+            int dy = PathGrid::NEIGHBOR_DY[i];
+            if (!PathGrid::CanStep(map, x, y, dx, dy)) continue;
+
+            int neighbor = (y + dy) * m_width + x + dx;
+            uint32_t cost = entry.first + PathGrid::StepCost(dx, dy);
+            if (cost < m_cost[neighbor]) {
+                m_cost[neighbor] = cost;
+                open.push_back({ cost, neighbor });
+                std::push_heap(open.begin(), open.end(), compare);
+                changed.push_back(neighbor);
+            }
+        }
+    }
+}
+
+// Point at the neighbor that gives this cell its cost
+void FlowField::UpdateDirection(const Tilemap& map, int cell) {
+    int x = cell % m_width;
+    int y = cell / m_width;
+    m_direction[cell] = NO_DIRECTION;
+    if (m_cost[cell] == UNREACHABLE || (x == m_goal.x && y == m_goal.y)) return;
+
+    uint32_t best = UNREACHABLE;
+    for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+        int dx = PathGrid::NEIGHBOR_DX[i];
+        int dy = PathGrid::NEIGHBOR_DY[i];
+        if (!PathGrid::CanStep(map, x, y, dx, dy)) continue;
+
+        uint32_t neighborCost = m_cost[(y + dy) * m_width + x + dx];
+        if (neighborCost == UNREACHABLE) continue;
+
+        uint32_t cost = neighborCost + PathGrid::StepCost(dx, dy);
+        if (cost < best) {
+            best = cost;
+            m_direction[cell] = static_cast<uint8_t>(i);
+        }
+    }
+}
+
+FlowFieldCache::FlowFieldCache(size_t maxFields)
+    : m_maxFields(std::max<size_t>(1, maxFields))
+{
+}
+
+const FlowField& FlowFieldCache::Get(const Tilemap& map, const GridPoint& goal) {
+    for (auto it = m_fields.begin(); it != m_fields.end(); ++it) {
+        if ((*it)->GetGoal() == goal) {
+            m_fields.splice(m_fields.begin(), m_fields, it);
+            return *m_fields.front();
+        }
+    }
+
+    auto field = std::make_unique<FlowField>();
+    field->Build(map, goal);
+    m_fields.push_front(std::move(field));
+    while (m_fields.size() > m_maxFields) {
+        m_fields.pop_back();
+    }
+    return *m_fields.front();
+}
+
+void FlowFieldCache::OnTileChanged(const Tilemap& map, int x, int y) {
+    for (auto& field : m_fields) {
+        field->OnTileChanged(map, x, y);
+    }
+}
+
+} // namespace engine
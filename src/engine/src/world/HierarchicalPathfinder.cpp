@@ -0,0 +1,416 @@
+#include "engine/world/HierarchicalPathfinder.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace engine {
+
+namespace {
+
+constexpr uint32_t UNREACHABLE = UINT32_MAX;
+constexpr uint8_t NO_PARENT = 0xFF;
+
+// Open border stretches at least this long get a transition at each end
+// instead of one in the middle
+constexpr int LONG_ENTRANCE = 6;
+
+// Abstract search endpoints (real node keys come from non-negative cells)
+constexpr uint64_t START_KEY = UINT64_MAX;
+constexpr uint64_t GOAL_KEY = UINT64_MAX - 1;
+
+} // namespace
+
+HierarchicalPathfinder::HierarchicalPathfinder(const Tilemap& map, int clusterSize)
+    : m_map(&map)
+    , m_clusterSize(std::max(1, clusterSize))
+{
+}
+
+void HierarchicalPathfinder::Build() {
+    m_clustersX = (m_map->GetWidth() + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (m_map->GetHeight() + m_clusterSize - 1) / m_clusterSize;
+    size_t clusterCount = static_cast<size_t>(m_clustersX) * m_clustersY;
+
+    m_nodes.clear();
+    m_clusterNodes.assign(clusterCount, {});
+    m_clusterDirty.assign(clusterCount, 1);
+    m_anyDirty = true;
+    RebuildDirtyClusters();
+}
+
+void HierarchicalPathfinder::OnTileChanged(int x, int y) {
+    if (m_clusterDirty.empty()) return;  // Not built yet
+    if (x < 0 || y < 0 || x >= m_map->GetWidth() || y >= m_map->GetHeight()) return;
+
+    // The cluster's own paths change, and so can the transitions on its
+    // borders, which the neighbours share
+    int clusterX = x / m_clusterSize;
+    int clusterY = y / m_clusterSize;
+    for (int i = -1; i < 4; ++i) {
+        int cx = i < 0 ? clusterX : clusterX + PathGrid::NEIGHBOR_DX[i];
+        int cy = i < 0 ? clusterY : clusterY + PathGrid::NEIGHBOR_DY[i];
+        if (cx >= 0 && cx < m_clustersX && cy >= 0 && cy < m_clustersY) {
+            m_clusterDirty[cy * m_clustersX + cx] = 1;
+        }
+    }
+    m_anyDirty = true;
+}
+
+bool HierarchicalPathfinder::FindPath(const GridPoint& start, const GridPoint& goal, std::vector<GridPoint>& path) {
+    path.clear();
+    if (!PathGrid::IsWalkable(*m_map, start.x, start.y) || !PathGrid::IsWalkable(*m_map, goal.x, goal.y)) {
+        return false;
+    }
+    if (start == goal) {
+        path.push_back(start);
+        return true;
+    }
+
+    if (m_clusterDirty.empty()) {
+        Build();
+    } else {
+        RebuildDirtyClusters();
+    }
+
+    // Nearby goals usually don't need the abstract graph at all
+    int startCluster = ClusterOf(start.x, start.y);
+    int goalCluster = ClusterOf(goal.x, goal.y);
+    if (startCluster == goalCluster) {
+        LoadCluster(startCluster);
+        if (SearchCluster(start, &goal)) {
+            path.push_back(start);
+            AppendLocalPath(start, goal, path);
+            return true;
+        }
+    }
+
+    // Hook the endpoints up to the nodes of their clusters (moves are
+    // reversible, so a search outward from the goal gives costs toward it)
+    std::vector<std::pair<uint64_t, uint32_t>> startEdges;
+    std::vector<std::pair<uint64_t, uint32_t>> goalEdges;
+    LoadCluster(goalCluster);
+    SearchCluster(goal, nullptr);
+    for (uint64_t key : m_clusterNodes[goalCluster]) {
+        uint32_t cost = GetLocalCost(m_nodes[key].cell);
+        if (cost != UNREACHABLE) goalEdges.push_back({ key, cost });
+    }
+    if (goalEdges.empty()) return false;
+
+    LoadCluster(startCluster);
+    SearchCluster(start, nullptr);
+    for (uint64_t key : m_clusterNodes[startCluster]) {
+        uint32_t cost = GetLocalCost(m_nodes[key].cell);
+        if (cost != UNREACHABLE) startEdges.push_back({ key, cost });
+    }
+    if (startEdges.empty()) return false;
+
+    // A* over the abstract graph
+    struct Record {
+        uint32_t cost;
+        uint64_t parent;
+    };
+    using OpenEntry = std::pair<uint32_t, uint64_t>;
+    std::greater<OpenEntry> compare;
+    std::unordered_map<uint64_t, Record> records;
+    std::vector<OpenEntry> open;
+
+    auto cellOf = [&](uint64_t key) -> const GridPoint& {
+        if (key == START_KEY) return start;
+        if (key == GOAL_KEY) return goal;
+        return m_nodes[key].cell;
+    };
+    auto heuristic = [&](const GridPoint& cell) {
+        return PathGrid::Heuristic(cell.x, cell.y, goal.x, goal.y);
+    };
+
+    records[START_KEY] = { 0, START_KEY };
+    open.push_back({ heuristic(start), START_KEY });
+    bool found = false;
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        OpenEntry entry = open.back();
+        open.pop_back();
+
+        uint64_t key = entry.second;
+        uint32_t cost = records[key].cost;
+        if (entry.first > cost + heuristic(cellOf(key))) continue;  // Stale entry
+        if (key == GOAL_KEY) {
+            found = true;
+            break;
+        }
+
+        auto relax = [&](uint64_t target, uint32_t stepCost) {
+            uint32_t newCost = cost + stepCost;
+            auto it = records.find(target);
+            if (it != records.end() && it->second.cost <= newCost) return;
+
+            records[target] = { newCost, key };
+            open.push_back({ newCost + heuristic(cellOf(target)), target });
+            std::push_heap(open.begin(), open.end(), compare);
+        };
+
+        if (key == START_KEY) {
+            for (const auto& edge : startEdges) relax(edge.first, edge.second);
+            continue;
+        }
+        const Node& node = m_nodes[key];
+        for (const Edge& edge : node.edges) relax(edge.target, edge.cost);
+        if (node.cluster == goalCluster) {
+            for (const auto& edge : goalEdges) {
+                if (edge.first == key) relax(GOAL_KEY, edge.second);
+            }
+        }
+    }
+    if (!found) return false;
+
+    std::vector<GridPoint> waypoints;
+    for (uint64_t key = GOAL_KEY; key != START_KEY; key = records[key].parent) {
+        waypoints.push_back(cellOf(key));
+    }
+    waypoints.push_back(start);
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Refine: intra-cluster hops by a local A*, border crossings are one step
+    path.push_back(start);
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const GridPoint& from = waypoints[i - 1];
+        const GridPoint& to = waypoints[i];
+        if (from == to) continue;
+
+        int cluster = ClusterOf(from.x, from.y);
+        if (cluster != ClusterOf(to.x, to.y)) {
+            path.push_back(to);
+            continue;
+        }
+        LoadCluster(cluster);
+        if (!SearchCluster(from, &to)) {
+            path.clear();
+            return false;
+        }
+        AppendLocalPath(from, to, path);
+    }
+    return true;
+}
+
+void HierarchicalPathfinder::GetClusterRect(int cluster, int& minX, int& minY, int& maxX, int& maxY) const {
+    minX = (cluster % m_clustersX) * m_clusterSize;
+    minY = (cluster / m_clustersX) * m_clusterSize;
+    maxX = std::min(minX + m_clusterSize, m_map->GetWidth()) - 1;
+    maxY = std::min(minY + m_clusterSize, m_map->GetHeight()) - 1;
+}
+
+// Dirty clusters lose all their nodes. Re-scanning their borders brings back
+// the transitions (inter-edges to clean neighbours keep their keys, since a
+// border only changes when one of its own two clusters was edited), then
+// intra-edges are recomputed for the dirty clusters alone
+void HierarchicalPathfinder::RebuildDirtyClusters() {
+    if (!m_anyDirty) return;
+    m_anyDirty = false;
+
+    int clusterCount = m_clustersX * m_clustersY;
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        if (!m_clusterDirty[cluster]) continue;
+        for (uint64_t key : m_clusterNodes[cluster]) {
+            m_nodes.erase(key);
+        }
+        m_clusterNodes[cluster].clear();
+    }
+
+    // Every border of a dirty cluster, each once: right and bottom always,
+    // left and top only when the cluster on the other side is clean
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        if (!m_clusterDirty[cluster]) continue;
+        int cx = cluster % m_clustersX;
+        int cy = cluster / m_clustersX;
+        if (cx + 1 < m_clustersX) AddBorderTransitions(cx, cy, true);
+        if (cy + 1 < m_clustersY) AddBorderTransitions(cx, cy, false);
+        if (cx > 0 && !m_clusterDirty[cluster - 1]) AddBorderTransitions(cx - 1, cy, true);
+        if (cy > 0 && !m_clusterDirty[cluster - m_clustersX]) AddBorderTransitions(cx, cy - 1, false);
+    }
+
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        if (!m_clusterDirty[cluster]) continue;
+        ConnectClusterNodes(cluster);
+        m_clusterDirty[cluster] = 0;
+    }
+}
+
+// Transitions on the right (vertical) or bottom border of a cluster
+void HierarchicalPathfinder::AddBorderTransitions(int clusterX, int clusterY, bool vertical) {
+    int minX, minY, maxX, maxY;
+    GetClusterRect(clusterY * m_clustersX + clusterX, minX, minY, maxX, maxY);
+
+    int first = vertical ? minY : minX;
+    int last = vertical ? maxY : maxX;
+    auto inside = [&](int i) { return vertical ? GridPoint{ maxX, i } : GridPoint{ i, maxY }; };
+    auto outside = [&](int i) { return vertical ? GridPoint{ maxX + 1, i } : GridPoint{ i, maxY + 1 }; };
+
+    int runStart = -1;
+    for (int i = first; i <= last + 1; ++i) {
+        bool open = false;
+        if (i <= last) {
+            GridPoint a = inside(i);
+            GridPoint b = outside(i);
+            open = PathGrid::IsWalkable(*m_map, a.x, a.y) && PathGrid::IsWalkable(*m_map, b.x, b.y);
+        }
+        if (open) {
+            if (runStart < 0) runStart = i;
+            continue;
+        }
+        if (runStart < 0) continue;
+
+        int runEnd = i - 1;
+        if (runEnd - runStart + 1 < LONG_ENTRANCE) {
+            int middle = (runStart + runEnd) / 2;
+            AddTransition(inside(middle), outside(middle));
+        } else {
+            AddTransition(inside(runStart), outside(runStart));
+            AddTransition(inside(runEnd), outside(runEnd));
+        }
+        runStart = -1;
+    }
+}
+
+void HierarchicalPathfinder::AddTransition(const GridPoint& a, const GridPoint& b) {
+    // References into an unordered_map survive insertions
+    Node& nodeA = FindOrAddNode(a);
+    Node& nodeB = FindOrAddNode(b);
+    uint64_t keyA = ChunkKey(a.x, a.y);
+    uint64_t keyB = ChunkKey(b.x, b.y);
+
+    auto link = [](Node& from, uint64_t target) {
+        for (const Edge& edge : from.edges) {
+            if (edge.target == target) return;
+        }
+        from.edges.push_back({ target, PathGrid::STRAIGHT_COST });
+    };
+    link(nodeA, keyB);
+    link(nodeB, keyA);
+}
+
+HierarchicalPathfinder::Node& HierarchicalPathfinder::FindOrAddNode(const GridPoint& cell) {
+    uint64_t key = ChunkKey(cell.x, cell.y);
+    auto [it, inserted] = m_nodes.try_emplace(key);
+    if (inserted) {
+        it->second.cell = cell;
+        it->second.cluster = ClusterOf(cell.x, cell.y);
+        m_clusterNodes[it->second.cluster].push_back(key);
+    }
+    return it->second;
+}
+
+// Intra-edges: one Dijkstra per node, bounded to the cluster
+void HierarchicalPathfinder::ConnectClusterNodes(int cluster) {
+    const std::vector<uint64_t>& keys = m_clusterNodes[cluster];
+    LoadCluster(cluster);
+    for (uint64_t key : keys) {
+        Node& node = m_nodes[key];
+        SearchCluster(node.cell, nullptr);
+        for (uint64_t other : keys) {
+            if (other == key) continue;
+
+            uint32_t cost = GetLocalCost(m_nodes[other].cell);
+            if (cost != UNREACHABLE) {
+                node.edges.push_back({ other, cost });
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::LoadCluster(int cluster) {
+    int minX, minY, maxX, maxY;
+    GetClusterRect(cluster, minX, minY, maxX, maxY);
+    m_localMinX = minX;
+    m_localMinY = minY;
+    m_localWidth = maxX - minX + 1;
+    m_localHeight = maxY - minY + 1;
+
+    m_localWalkable.resize(static_cast<size_t>(m_localWidth) * m_localHeight);
+    m_rowScratch.resize(m_localWidth);
+    for (int y = 0; y < m_localHeight; ++y) {
+        m_map->GetTileRow(m_map->GetCollisionLayer(), minX, minY + y, m_localWidth, m_rowScratch.data());
+        for (int x = 0; x < m_localWidth; ++x) {
+            m_localWalkable[y * m_localWidth + x] = !m_map->IsTileSolid(m_rowScratch[x]);
+        }
+    }
+}
+
+bool HierarchicalPathfinder::IsLocalWalkable(int x, int y) const {
+    x -= m_localMinX;
+    y -= m_localMinY;
+    return x >= 0 && x < m_localWidth && y >= 0 && y < m_localHeight && m_localWalkable[y * m_localWidth + x];
+}
+
+// Fills m_localCost / m_localParent over the loaded cluster, with the same
+// move rules as PathGrid::CanStep. With a target this is A* and stops once
+// the target is settled
+bool HierarchicalPathfinder::SearchCluster(const GridPoint& from, const GridPoint* target) {
+    m_localCost.assign(m_localWalkable.size(), UNREACHABLE);
+    m_localParent.assign(m_localWalkable.size(), NO_PARENT);
+    if (!IsLocalWalkable(from.x, from.y)) return false;
+    if (target && !IsLocalWalkable(target->x, target->y)) return false;
+
+    auto heuristic = [&](int x, int y) {
+        return target ? PathGrid::Heuristic(x, y, target->x, target->y) : 0u;
+    };
+
+    using OpenEntry = std::pair<uint32_t, int>;
+    std::greater<OpenEntry> compare;
+    std::vector<OpenEntry> open;
+    int fromCell = (from.y - m_localMinY) * m_localWidth + (from.x - m_localMinX);
+    m_localCost[fromCell] = 0;
+    open.push_back({ heuristic(from.x, from.y), fromCell });
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), compare);
+        OpenEntry entry = open.back();
+        open.pop_back();
+
+        int x = m_localMinX + entry.second % m_localWidth;
+        int y = m_localMinY + entry.second / m_localWidth;
+        uint32_t cost = m_localCost[entry.second];
+        if (entry.first > cost + heuristic(x, y)) continue;  // Stale entry
+        if (target && x == target->x && y == target->y) return true;
+
+        for (int i = 0; i < PathGrid::NEIGHBOR_COUNT; ++i) {
+            int dx = PathGrid::NEIGHBOR_DX[i];
+            int dy = PathGrid::NEIGHBOR_DY[i];
+            if (!IsLocalWalkable(x + dx, y + dy)) continue;
+            if (dx != 0 && dy != 0 && (!IsLocalWalkable(x + dx, y) || !IsLocalWalkable(x, y + dy))) continue;
+
+            int neighbor = (y + dy - m_localMinY) * m_localWidth + (x + dx - m_localMinX);
+            uint32_t newCost = cost + PathGrid::StepCost(dx, dy);
+            if (newCost < m_localCost[neighbor]) {
+                m_localCost[neighbor] = newCost;
+                m_localParent[neighbor] = static_cast<uint8_t>(i);
+                open.push_back({ newCost + heuristic(x + dx, y + dy), neighbor });
+                std::push_heap(open.begin(), open.end(), compare);
+            }
+        }
+    }
+    return target == nullptr;
+}
+
+uint32_t HierarchicalPathfinder::GetLocalCost(const GridPoint& cell) const {
+    int lx = cell.x - m_localMinX;
+    int ly = cell.y - m_localMinY;
+    if (lx < 0 || ly < 0 || lx >= m_localWidth || ly >= m_localHeight) return UNREACHABLE;
+    return m_localCost[ly * m_localWidth + lx];
+}
+
+// Walk the parent steps of the last search back from to, then append the
+// cells after from in forward order
+void HierarchicalPathfinder::AppendLocalPath(const GridPoint& from, const GridPoint& to,
+                                             std::vector<GridPoint>& path) const {
+    size_t first = path.size();
+    GridPoint cell = to;
+    while (cell != from) {
+        path.push_back(cell);
+        uint8_t dir = m_localParent[(cell.y - m_localMinY) * m_localWidth + (cell.x - m_localMinX)];
+        cell.x -= PathGrid::NEIGHBOR_DX[dir];
+        cell.y -= PathGrid::NEIGHBOR_DY[dir];
+    }
+    std::reverse(path.begin() + first, path.end());
+}
+
+} // namespace engine
@@ -0,0 +1,163 @@
+#include "engine/world/RegionFile.h"
+#include <SDL3/SDL_log.h>
+#include <cstring>
+#include <fstream>
+
+namespace engine {
+
+// Records reserved when a file is created (and the minimum growth step)
+static constexpr size_t INITIAL_RECORD_CAPACITY = 64;
+
+RegionFile::RegionFile(int chunkSize)
+    : m_chunkSize(chunkSize)
+{
+}
+
+RegionFile::~RegionFile() {
+    Close();
+}
+
+size_t RegionFile::GetTileBytes() const {
+    return static_cast<size_t>(m_chunkSize) * m_chunkSize * sizeof(int32_t);
+}
+
+size_t RegionFile::GetRecordSize() const {
+    return sizeof(RegionRecordHeader) + GetTileBytes();
+}
+
+// An existing file is checked before it is mapped for writing, so a file
+// that isn't ours is never grown or given a header
+bool RegionFile::Open(const std::string& path) {
+    Close();
+
+    size_t existingSize = 0;
+    {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        if (existing) {
+            existingSize = static_cast<size_t>(existing.tellg());
+        }
+        if (existingSize > 0) {
+            RegionHeader header = {};
+            existing.seekg(0);
+            if (existingSize < sizeof(RegionHeader) ||
+                !existing.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                std::memcmp(header.magic, BWLD_MAGIC, sizeof(BWLD_MAGIC)) != 0) {
+                SDL_Log("RegionFile: '%s' is not a region file", path.c_str());
+                return false;
+            }
+            if (header.version != BWLD_VERSION || header.chunkSize != m_chunkSize) {
+                SDL_Log("RegionFile: '%s' has version %u, chunk size %u (expected %u, %d)", path.c_str(),
+                        header.version, header.chunkSize, BWLD_VERSION, m_chunkSize);
+                return false;
+            }
+        }
+    }
+
+    // Only a new (or empty) file is created and sized here
+    size_t minSize = existingSize > 0 ? sizeof(RegionHeader)
+                                      : sizeof(RegionHeader) + INITIAL_RECORD_CAPACITY * GetRecordSize();
+    if (!m_file.OpenWritable(path, minSize)) {
+        return false;
+    }
+    m_path = path;
+
+    RegionHeader* header = reinterpret_cast<RegionHeader*>(m_file.GetWritableData());
+    if (existingSize == 0) {
+        std::memcpy(header->magic, BWLD_MAGIC, sizeof(BWLD_MAGIC));
+        header->version = BWLD_VERSION;
+        header->chunkSize = static_cast<uint16_t>(m_chunkSize);
+        header->recordCount = 0;
+        header->reserved = 0;
+    }
+
+    m_capacity = (m_file.GetSize() - sizeof(RegionHeader)) / GetRecordSize();
+    if (header->recordCount > m_capacity) {
+        SDL_Log("RegionFile: '%s' is truncated (%u records, room for %zu)", path.c_str(),
+                header->recordCount, m_capacity);
+        Close();
+        return false;
+    }
+
+    // Index the records; only the small record headers are touched
+    const uint8_t* records = m_file.GetData() + sizeof(RegionHeader);
+    m_records.reserve(header->recordCount);
+    for (uint32_t i = 0; i < header->recordCount; ++i) {
+        RegionRecordHeader record;
+        std::memcpy(&record, records + i * GetRecordSize(), sizeof(record));
+        m_records[ChunkKey(record.chunkX, record.chunkY)] = i;
+    }
+    return true;
+}
+
+void RegionFile::Close() {
+    if (m_file.IsOpen()) {
+        m_file.Flush();
+    }
+    m_file.Close();
+    m_records.clear();
+    m_capacity = 0;
+}
+
+bool RegionFile::Read(int chunkX, int chunkY, int32_t* tiles) const {
+    auto it = m_records.find(ChunkKey(chunkX, chunkY));
+    if (it == m_records.end()) {
+        return false;
+    }
+
+    const uint8_t* record = m_file.GetData() + sizeof(RegionHeader) + it->second * GetRecordSize();
+    std::memcpy(tiles, record + sizeof(RegionRecordHeader), GetTileBytes());
+    return true;
+}
+
+bool RegionFile::Write(int chunkX, int chunkY, const int32_t* tiles) {
+    if (!IsOpen()) return false;
+
+    uint64_t key = ChunkKey(chunkX, chunkY);
+    auto it = m_records.find(key);
+    uint32_t index;
+    if (it != m_records.end()) {
+        index = it->second;
+    } else {
+        if (m_records.size() >= m_capacity && !Grow()) {
+            return false;
+        }
+        index = static_cast<uint32_t>(m_records.size());
+    }
+
+    uint8_t* record = m_file.GetWritableData() + sizeof(RegionHeader) + index * GetRecordSize();
+    RegionRecordHeader recordHeader = { chunkX, chunkY };
+    std::memcpy(record, &recordHeader, sizeof(recordHeader));
+    std::memcpy(record + sizeof(RegionRecordHeader), tiles, GetTileBytes());
+
+    // Publish the record only after its data is in place
+    if (it == m_records.end()) {
+        m_records[key] = index;
+        reinterpret_cast<RegionHeader*>(m_file.GetWritableData())->recordCount =
+            static_cast<uint32_t>(m_records.size());
+    }
+    return true;
+}
+
+bool RegionFile::Flush() {
+    return m_file.Flush();
+}
+
+// Double the record capacity (remaps the file, invalidating old pointers)
+bool RegionFile::Grow() {
+    size_t capacity = m_capacity > 0 ? m_capacity * 2 : INITIAL_RECORD_CAPACITY;
+    size_t size = sizeof(RegionHeader) + capacity * GetRecordSize();
+
+    m_file.Flush();
+    m_file.Close();
+    if (!m_file.OpenWritable(m_path, size)) {
+        SDL_Log("RegionFile: Failed to grow '%s' to %zu records", m_path.c_str(), capacity);
+        m_records.clear();
+        m_capacity = 0;
+        return false;
+    }
+
+    m_capacity = (m_file.GetSize() - sizeof(RegionHeader)) / GetRecordSize();
+    return true;
+}
+
+} // namespace engine
@@ -0,0 +1,402 @@
+#include "engine/world/TileWorld.h"
+#include "engine/gfx/Tilemap.h"
+#include "engine/gfx/SpriteSheet.h"
+#include "engine/gfx/Renderer2D.h"
+#include "engine/gfx/VertexArray.h"
+#include "engine/gfx/VertexBuffer.h"
+#include "engine/gfx/QuadVertex.h"
+#include "engine/math/Vec4.h"
+#include <SDL3/SDL_log.h>
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+TileWorld::TileWorld(float tileSize)
+    : m_tileSize(tileSize)
+    , m_region(CHUNK_SIZE)
+{
+}
+
+TileWorld::~TileWorld() {
+    Close();
+}
+
+bool TileWorld::Open(const std::string& regionPath) {
+    Close();
+    m_focusValid = false;
+    return m_region.Open(regionPath);
+}
+
+// Evicting everything queues saves for modified chunks; the streaming thread
+// drains its queue before it exits
+void TileWorld::Close() {
+    if (m_thread.joinable()) {
+        std::vector<StreamJob> saves;
+        for (auto& [key, chunk] : m_chunks) {
+            if (chunk.modified) {
+                StreamJob job;
+                job.type = StreamJob::Type::Save;
+                job.chunkX = ChunkKeyX(key);
+                job.chunkY = ChunkKeyY(key);
+                job.tiles = std::move(chunk.tiles);
+                saves.push_back(std::move(job));
+            }
+        }
+        QueueJobs(saves);
+        StopStreaming();
+    }
+
+    m_chunks.clear();
+    m_pendingLoads.clear();
+    m_loaded.clear();
+    m_jobs.clear();
+    m_region.Close();
+    m_focusValid = false;
+}
+
+void TileWorld::SetGenerator(Generator generator) {
+    if (m_thread.joinable()) {
+        SDL_Log("TileWorld: SetGenerator called while streaming, ignored");
+        return;
+    }
+    m_generator = std::move(generator);
+}
+
+void TileWorld::SetStreamRadius(int radius) {
+    m_streamRadius = std::max(0, radius);
+    m_focusValid = false;
+}
+
+// Loads and evictions only change when the focus enters another chunk
+void TileWorld::Update(const Vec2& focus) {
+    if (!m_thread.joinable()) {
+        StartStreaming();
+    }
+
+    AdoptLoadedChunks();
+
+    float chunkWorldSize = CHUNK_SIZE * m_tileSize;
+    int focusX = static_cast<int>(std::floor(focus.x / chunkWorldSize));
+    int focusY = static_cast<int>(std::floor(focus.y / chunkWorldSize));
+    if (!m_focusValid || focusX != m_focusChunkX || focusY != m_focusChunkY) {
+        m_focusChunkX = focusX;
+        m_focusChunkY = focusY;
+        m_focusValid = true;
+        RequestAndEvictChunks();
+    }
+}
+
+void TileWorld::Flush() {
+    std::vector<StreamJob> jobs;
+    for (auto& [key, chunk] : m_chunks) {
+        if (!chunk.modified) continue;
+
+        // The resident copy stays editable, the thread writes a snapshot
+        StreamJob job;
+        job.type = StreamJob::Type::Save;
+        job.chunkX = ChunkKeyX(key);
+        job.chunkY = ChunkKeyY(key);
+        job.tiles = std::make_unique<ChunkTiles>(*chunk.tiles);
+        jobs.push_back(std::move(job));
+        chunk.modified = false;
+    }
+
+    StreamJob sync;
+    sync.type = StreamJob::Type::Sync;
+    jobs.push_back(std::move(sync));
+    QueueJobs(jobs);
+
+    if (!m_thread.joinable()) {
+        StartStreaming();
+    }
+}
+
+void TileWorld::WaitForStreaming() {
+    if (m_thread.joinable()) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_jobs.empty() && !m_jobActive; });
+    }
+    AdoptLoadedChunks();
+}
+
+int32_t TileWorld::GetTile(int x, int y) const {
+    int chunkX = FloorDiv(x, CHUNK_SIZE);
+    int chunkY = FloorDiv(y, CHUNK_SIZE);
+    const Chunk* chunk = FindChunk(chunkX, chunkY);
+    if (!chunk) return EMPTY_TILE;
+
+    int localX = x - chunkX * CHUNK_SIZE;
+    int localY = y - chunkY * CHUNK_SIZE;
+    return (*chunk->tiles)[localY * CHUNK_SIZE + localX];
+}
+
+bool TileWorld::SetTile(int x, int y, int32_t tileIndex) {
+    int chunkX = FloorDiv(x, CHUNK_SIZE);
+    int chunkY = FloorDiv(y, CHUNK_SIZE);
+    Chunk* chunk = FindChunk(chunkX, chunkY);
+    if (!chunk) return false;
+
+    int localX = x - chunkX * CHUNK_SIZE;
+    int localY = y - chunkY * CHUNK_SIZE;
+    int32_t& tile = (*chunk->tiles)[localY * CHUNK_SIZE + localX];
+    if (tile != tileIndex) {
+        tile = tileIndex;
+        chunk->modified = true;
+        chunk->meshDirty = true;
+    }
+    return true;
+}
+
+bool TileWorld::IsChunkLoaded(int chunkX, int chunkY) const {
+    return FindChunk(chunkX, chunkY) != nullptr;
+}
+
+const int32_t* TileWorld::GetChunkTiles(int chunkX, int chunkY) const {
+    const Chunk* chunk = FindChunk(chunkX, chunkY);
+    return chunk ? chunk->tiles->data() : nullptr;
+}
+
+// Only resident chunks inside the view are visited; the range is clamped to
+// the keep radius so zooming far out does not walk thousands of empty keys
+void TileWorld::Draw(Renderer2D& renderer, const Tilemap& tileTypes) const {
+    const SpriteSheet* sheet = tileTypes.GetSpriteSheet();
+    if (!sheet || !sheet->IsValid() || !m_focusValid) {
+        return;
+    }
+
+    const Texture2D* texture = sheet->GetTexture();
+    if (!texture) return;
+
+    float chunkWorldSize = CHUNK_SIZE * m_tileSize;
+    int keepRadius = m_streamRadius + 1;
+    const Vec4& view = renderer.GetViewBounds();
+    int minX = std::max(m_focusChunkX - keepRadius, static_cast<int>(std::floor(view.x / chunkWorldSize)));
+    int minY = std::max(m_focusChunkY - keepRadius, static_cast<int>(std::floor(view.y / chunkWorldSize)));
+    int maxX = std::min(m_focusChunkX + keepRadius, static_cast<int>(std::floor(view.z / chunkWorldSize)));
+    int maxY = std::min(m_focusChunkY + keepRadius, static_cast<int>(std::floor(view.w / chunkWorldSize)));
+    uint64_t tileTypeVersion = tileTypes.GetTileTypeVersion();
+    const TileTypeTable* tileTable = tileTypes.GetTileTypeTable();
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            const Chunk* chunk = FindChunk(cx, cy);
+            if (!chunk) continue;
+
+            if (chunk->meshDirty || chunk->meshTileTypeVersion != tileTypeVersion) {
+                BuildChunkMesh(renderer, tileTypes, *chunk, cx, cy);
+                chunk->meshTileTypeVersion = tileTypeVersion;
+            }
+            if (chunk->indexCount > 0) {
+                renderer.DrawMesh(*chunk->mesh, chunk->indexCount, *texture,
+                                  Vec2(cx * chunkWorldSize, cy * chunkWorldSize),
+                                  Vec4(1.0f, 1.0f, 1.0f, 1.0f), tileTable);
+            }
+        }
+    }
+}
+
+Vec2 TileWorld::WorldToGrid(const Vec2& worldPos) const {
+    return Vec2(worldPos.x / m_tileSize, worldPos.y / m_tileSize);
+}
+
+void TileWorld::StartStreaming() {
+    m_stopping = false;
+    m_thread = std::thread(&TileWorld::StreamLoop, this);
+}
+
+void TileWorld::StopStreaming() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobAvailable.notify_all();
+    m_thread.join();
+    m_stopping = false;
+}
+
+// Jobs run in submission order, so a load queued after a save of the same
+// chunk always sees the saved data
+void TileWorld::StreamLoop() {
+    while (true) {
+        StreamJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty()) {
+                return;  // Stopping and nothing left to do
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_jobActive = true;
+        }
+
+        RunJob(job);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (job.type == StreamJob::Type::Load) {
+                m_loaded.push_back(std::move(job));
+            }
+            m_jobActive = false;
+            if (m_jobs.empty()) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+// Streaming thread: the only place the region file is read or written
+void TileWorld::RunJob(StreamJob& job) {
+    switch (job.type) {
+        case StreamJob::Type::Load:
+            job.tiles = std::make_unique<ChunkTiles>();
+            if (!m_region.IsOpen() || !m_region.Read(job.chunkX, job.chunkY, job.tiles->data())) {
+                job.tiles->fill(EMPTY_TILE);
+                if (m_generator) {
+                    m_generator(job.chunkX, job.chunkY, job.tiles->data());
+                }
+            }
+            break;
+
+        case StreamJob::Type::Save:
+            if (m_region.IsOpen() && !m_region.Write(job.chunkX, job.chunkY, job.tiles->data())) {
+                SDL_Log("TileWorld: Failed to save chunk (%d, %d)", job.chunkX, job.chunkY);
+            }
+            break;
+
+        case StreamJob::Type::Sync:
+            if (m_region.IsOpen()) {
+                m_region.Flush();
+            }
+            break;
+    }
+}
+
+void TileWorld::QueueJobs(std::vector<StreamJob>& jobs) {
+    if (jobs.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (StreamJob& job : jobs) {
+            m_jobs.push_back(std::move(job));
+        }
+    }
+    jobs.clear();
+    m_jobAvailable.notify_one();
+}
+
+// Chunks that arrive after the focus moved away are dropped again
+void TileWorld::AdoptLoadedChunks() {
+    std::vector<StreamJob> loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        loaded.swap(m_loaded);
+    }
+
+    for (StreamJob& job : loaded) {
+        uint64_t key = ChunkKey(job.chunkX, job.chunkY);
+        m_pendingLoads.erase(key);
+        if (!InKeepRange(job.chunkX, job.chunkY) || m_chunks.count(key) > 0) {
+            continue;
+        }
+
+        Chunk chunk;
+        chunk.tiles = std::move(job.tiles);
+        m_chunks.emplace(key, std::move(chunk));
+    }
+}
+
+void TileWorld::RequestAndEvictChunks() {
+    std::vector<StreamJob> jobs;
+
+    // Evict (modified chunks hand their tiles to a save job)
+    for (auto it = m_chunks.begin(); it != m_chunks.end();) {
+        int chunkX = ChunkKeyX(it->first);
+        int chunkY = ChunkKeyY(it->first);
+        if (InKeepRange(chunkX, chunkY)) {
+            ++it;
+            continue;
+        }
+
+        if (it->second.modified) {
+            StreamJob job;
+            job.type = StreamJob::Type::Save;
+            job.chunkX = chunkX;
+            job.chunkY = chunkY;
+            job.tiles = std::move(it->second.tiles);
+            jobs.push_back(std::move(job));
+        }
+        it = m_chunks.erase(it);
+    }
+
+    // Request missing chunks, nearest first
+    std::vector<StreamJob> loads;
+    for (int dy = -m_streamRadius; dy <= m_streamRadius; ++dy) {
+        for (int dx = -m_streamRadius; dx <= m_streamRadius; ++dx) {
+            int chunkX = m_focusChunkX + dx;
+            int chunkY = m_focusChunkY + dy;
+            uint64_t key = ChunkKey(chunkX, chunkY);
+            if (m_chunks.count(key) > 0 || !m_pendingLoads.insert(key).second) {
+                continue;
+            }
+
+            StreamJob job;
+            job.type = StreamJob::Type::Load;
+            job.chunkX = chunkX;
+            job.chunkY = chunkY;
+            loads.push_back(std::move(job));
+        }
+    }
+    std::sort(loads.begin(), loads.end(), [this](const StreamJob& a, const StreamJob& b) {
+        int ax = a.chunkX - m_focusChunkX, ay = a.chunkY - m_focusChunkY;
+        int bx = b.chunkX - m_focusChunkX, by = b.chunkY - m_focusChunkY;
+        return ax * ax + ay * ay < bx * bx + by * by;
+    });
+
+    for (StreamJob& job : loads) {
+        jobs.push_back(std::move(job));
+    }
+    QueueJobs(jobs);
+}
+
+bool TileWorld::InKeepRange(int chunkX, int chunkY) const {
+    int keepRadius = m_streamRadius + 1;
+    return std::abs(chunkX - m_focusChunkX) <= keepRadius &&
+           std::abs(chunkY - m_focusChunkY) <= keepRadius;
+}
+
+// Mesh is in chunk-local space; Draw places it with the DrawMesh offset
+// (world cells are still passed on so animated tiles get their own phase)
+void TileWorld::BuildChunkMesh(Renderer2D& renderer, const Tilemap& tileTypes, const Chunk& chunk,
+                               int chunkX, int chunkY) const {
+    chunk.meshDirty = false;
+
+    std::vector<QuadVertex> vertices;
+    vertices.reserve(CHUNK_TILES * VERTICES_PER_QUAD);
+    tileTypes.AppendTileQuads(chunk.tiles->data(), CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE,
+                              Vec2(0.0f, 0.0f), vertices, chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE);
+
+    chunk.indexCount = static_cast<uint32_t>(vertices.size() / VERTICES_PER_QUAD) * INDICES_PER_QUAD;
+    if (vertices.empty()) {
+        chunk.mesh.reset();
+        chunk.vertices.reset();
+        return;
+    }
+
+    chunk.vertices = std::make_unique<VertexBuffer>(vertices.data(), vertices.size() * sizeof(QuadVertex));
+    chunk.mesh = std::make_unique<VertexArray>();
+    renderer.SetupMesh(*chunk.mesh, *chunk.vertices);
+}
+
+TileWorld::Chunk* TileWorld::FindChunk(int chunkX, int chunkY) {
+    auto it = m_chunks.find(ChunkKey(chunkX, chunkY));
+    return it != m_chunks.end() ? &it->second : nullptr;
+}
+
+const TileWorld::Chunk* TileWorld::FindChunk(int chunkX, int chunkY) const {
+    auto it = m_chunks.find(ChunkKey(chunkX, chunkY));
+    return it != m_chunks.end() ? &it->second : nullptr;
+}
+
+} // namespace engine
@@ -84,37 +84,21 @@ public:
         // Apply gravitational accel
         m_playerVel.y += GRAVITY * deltaTime;
 
-        // Integrate
-        engine::Vec2 newPos = m_playerPos + m_playerVel * deltaTime;
+        // Integrate, stopping at obstacles (swept, so fast moves cannot tunnel)
         engine::Vec2 halfSize = m_playerSize * 0.5f;
+        engine::AABB playerBox = engine::AABB::FromCenter(m_playerPos, halfSize);
+        engine::MoveResult move = engine::Collision::MoveAndSlide(playerBox, m_playerVel * deltaTime, m_obstacles);
+        engine::Vec2 newPos = m_playerPos + move.delta;
 
-        m_isColliding = false;
-        m_onGround = false;
+        m_isColliding = move.hitX || move.hitY;
+        m_onGround = move.hitY && move.normal.y > 0.0f;
 
-        // Collide
-        for (const auto& obstacle : m_obstacles) {
-            engine::AABB playerBox = engine::AABB::FromCenter(newPos, halfSize);
-            engine::Vec2 separation = engine::Collision::GetSeparation(playerBox, obstacle);
-
-            if (separation.x != 0.0f || separation.y != 0.0f) {
-                m_isColliding = true;
-                newPos += separation;
-
-                // Vertical collision
-                if (separation.y > 0.0f) {
-                    // Landed on something
-                    m_playerVel.y = 0.0f;
-                    m_onGround = true;
-                } else if (separation.y < 0.0f) {
-                    // Hit ceiling
-                    m_playerVel.y = 0.0f;
-                }
-
-                // Horizontal collision
-                if (separation.x != 0.0f) {
-                    m_playerVel.x = 0.0f;
-                }
-            }
+        if (move.hitX) {
+            m_playerVel.x = 0.0f;
+        }
+        if (move.hitY) {
+            // Landed on something or hit a ceiling
+            m_playerVel.y = 0.0f;
         }
 
         m_playerPos = newPos;
@@ -0,0 +1,102 @@
+#include "MaxRectsPacker.h"
+#include <algorithm>
+#include <climits>
+
+static bool Contains(const MaxRectsPacker::Rect& outer, const MaxRectsPacker::Rect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.w <= outer.x + outer.w &&
+           inner.y + inner.h <= outer.y + outer.h;
+}
+
+MaxRectsPacker::MaxRectsPacker(int width, int height) {
+    m_freeRects.push_back({ 0, 0, width, height });
+}
+
+// Best short side fit: pick the free rect leaving the smallest leftover on its
+// tighter side; ties go to the long side, then top-most, then left-most
+bool MaxRectsPacker::Insert(int w, int h, Rect& out) {
+    int bestShort = INT_MAX;
+    int bestLong = INT_MAX;
+    const Rect* best = nullptr;
+
+    for (const Rect& free : m_freeRects) {
+        if (w > free.w || h > free.h) continue;
+
+        int leftoverX = free.w - w;
+        int leftoverY = free.h - h;
+        int shortSide = std::min(leftoverX, leftoverY);
+        int longSide = std::max(leftoverX, leftoverY);
+
+        bool better = shortSide < bestShort ||
+                      (shortSide == bestShort && longSide < bestLong) ||
+                      (shortSide == bestShort && longSide == bestLong && best &&
+                       (free.y < best->y || (free.y == best->y && free.x < best->x)));
+        if (better) {
+            bestShort = shortSide;
+            bestLong = longSide;
+            best = &free;
+        }
+    }
+
+    if (!best) return false;
+
+    out = { best->x, best->y, w, h };
+    SplitFreeRects(out);
+    PruneFreeRects();
+
+    m_usedWidth = std::max(m_usedWidth, out.x + out.w);
+    m_usedHeight = std::max(m_usedHeight, out.y + out.h);
+    return true;
+}
+
+// Replace every free rect overlapping the used one by up to four maximal
+// rects covering what is left of it
+void MaxRectsPacker::SplitFreeRects(const Rect& used) {
+    std::vector<Rect> result;
+    result.reserve(m_freeRects.size() + 4);
+
+    for (const Rect& free : m_freeRects) {
+        bool overlaps = used.x < free.x + free.w && used.x + used.w > free.x &&
+                        used.y < free.y + free.h && used.y + used.h > free.y;
+        if (!overlaps) {
+            result.push_back(free);
+            continue;
+        }
+
+        if (used.x > free.x) {  // Left part
+            result.push_back({ free.x, free.y, used.x - free.x, free.h });
+        }
+        if (used.x + used.w < free.x + free.w) {  // Right part
+            result.push_back({ used.x + used.w, free.y, free.x + free.w - (used.x + used.w), free.h });
+        }
+        if (used.y > free.y) {  // Top part
+            result.push_back({ free.x, free.y, free.w, used.y - free.y });
+        }
+        if (used.y + used.h < free.y + free.h) {  // Bottom part
+            result.push_back({ free.x, used.y + used.h, free.w, free.y + free.h - (used.y + used.h) });
+        }
+    }
+
+    m_freeRects = std::move(result);
+}
+
+// Drop free rects fully inside another one (keeps the first of identical pairs)
+void MaxRectsPacker::PruneFreeRects() {
+    std::vector<Rect> pruned;
+    pruned.reserve(m_freeRects.size());
+
+    for (size_t i = 0; i < m_freeRects.size(); ++i) {
+        bool redundant = false;
+        for (size_t j = 0; j < m_freeRects.size() && !redundant; ++j) {
+            if (i == j || !Contains(m_freeRects[j], m_freeRects[i])) continue;
+            // Identical rects contain each other, keep the lower index
+            bool identical = Contains(m_freeRects[i], m_freeRects[j]);
+            redundant = !identical || j < i;
+        }
+        if (!redundant) {
+            pruned.push_back(m_freeRects[i]);
+        }
+    }
+
+    m_freeRects = std::move(pruned);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * MaxRects bin packer (best short side fit, no rotation).
+ * Keeps the list of maximal free rectangles of one page; every insert
+ * splits the free rectangles it overlaps and prunes contained ones.
+ * Results depend only on the insert order, so packing is deterministic.
+ */
+class MaxRectsPacker {
+public:
+    struct Rect {
+        int x = 0;
+        int y = 0;
+        int w = 0;
+        int h = 0;
+    };
+
+    MaxRectsPacker(int width, int height);
+
+    // Place a w x h rectangle, returns false if it does not fit
+    bool Insert(int w, int h, Rect& out);
+
+    // Extent of everything placed so far
+    int GetUsedWidth() const { return m_usedWidth; }
+    int GetUsedHeight() const { return m_usedHeight; }
+
+private:
+    std::vector<Rect> m_freeRects;
+    int m_usedWidth = 0;
+    int m_usedHeight = 0;
+
+    void SplitFreeRects(const Rect& used);
+    void PruneFreeRects();
+};
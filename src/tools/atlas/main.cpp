@@ -0,0 +1,378 @@
+#include "MaxRectsPacker.h"
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * boxer_atlas - packs a folder of images into sprite sheet atlases.
+ *
+ * Usage:
+ *   boxer_atlas [options] <input_dir> <output_prefix>
+ *
+ * Options:
+ *   --size <n>       Maximum page width/height (default 2048)
+ *   --padding <n>    Transparent gap between sprites in pixels (default 2)
+ *   --extrude <n>    Repeat sprite edge pixels n times outwards (default 1)
+ *   --trim           Crop fully transparent borders (offset and source size go to
+ *                    the JSON; draw with Sprite::GetTrimmedQuad)
+ *   --filter <mode>  "filter" written to the JSON (nearest, linear, ...)
+ *   --no-pot         Keep exact page size instead of rounding to powers of two
+ *
+ * Writes <prefix>.png + <prefix>.json, or <prefix>_<page>.png/.json when the
+ * images need several pages. Each JSON loads with SpriteSheet::LoadFromFile.
+ * Sprite names are paths relative to input_dir without extension.
+ *
+ * Output is deterministic: inputs are sorted and packing has no random
+ * choices, so unchanged inputs give byte-identical files (safe to cache).
+ */
+
+namespace fs = std::filesystem;
+
+struct AtlasOptions {
+    int maxSize = 2048;
+    int padding = 2;
+    int extrude = 1;
+    bool trim = false;
+    bool powerOfTwo = true;
+    std::string filter;
+};
+
+struct SourceImage {
+    std::string name;             // Relative path without extension, '/' separated
+    std::vector<uint8_t> pixels;  // RGBA8, top row first (cropped if trimmed)
+    int width = 0;
+    int height = 0;
+    int trimX = 0;                // Offset of the kept region in the source image
+    int trimY = 0;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+};
+
+struct Placement {
+    const SourceImage* image;
+    int x;  // Top-left of the sprite pixels (inside the extrusion)
+    int y;
+};
+
+struct AtlasPage {
+    MaxRectsPacker packer;
+    std::vector<Placement> placements;
+
+    explicit AtlasPage(int size) : packer(size, size) {}
+};
+
+static void PrintUsage() {
+    std::printf("Usage: boxer_atlas [--size n] [--padding n] [--extrude n] [--trim] "
+                "[--filter mode] [--no-pot] <input_dir> <output_prefix>\n");
+}
+
+static bool IsImageFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+}
+
+static int NextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Crop to the bounding box of non-transparent pixels
+static void TrimImage(SourceImage& image) {
+    int minX = image.width, minY = image.height, maxX = -1, maxY = -1;
+    for (int y = 0; y < image.height; ++y) {
+        for (int x = 0; x < image.width; ++x) {
+            if (image.pixels[(static_cast<size_t>(y) * image.width + x) * 4 + 3] != 0) {
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+
+    if (maxX < 0) {
+        // Fully transparent: keep a single pixel so the sprite still exists
+        minX = minY = maxX = maxY = 0;
+    }
+    if (minX == 0 && minY == 0 && maxX == image.width - 1 && maxY == image.height - 1) {
+        return;
+    }
+
+    int width = maxX - minX + 1;
+    int height = maxY - minY + 1;
+    std::vector<uint8_t> cropped(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* src = &image.pixels[(static_cast<size_t>(minY + y) * image.width + minX) * 4];
+        std::memcpy(&cropped[static_cast<size_t>(y) * width * 4], src, static_cast<size_t>(width) * 4);
+    }
+
+    image.pixels = std::move(cropped);
+    image.width = width;
+    image.height = height;
+    image.trimX = minX;
+    image.trimY = minY;
+}
+
+static bool LoadImages(const fs::path& inputDir, const AtlasOptions& options,
+                       std::vector<SourceImage>& images) {
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& entry : fs::recursive_directory_iterator(inputDir, ec)) {
+        if (entry.is_regular_file() && IsImageFile(entry.path())) {
+            files.push_back(entry.path());
+        }
+    }
+    if (ec) {
+        std::fprintf(stderr, "Failed to read '%s': %s\n", inputDir.string().c_str(), ec.message().c_str());
+        return false;
+    }
+    std::sort(files.begin(), files.end());  // Directory order is not stable across systems
+
+    // Rows stay top-down: the PNG we write is flipped by the runtime loader like any other
+    stbi_set_flip_vertically_on_load(false);
+
+    for (const auto& file : files) {
+        SourceImage image;
+        image.name = fs::relative(file, inputDir).replace_extension().generic_string();
+
+        int channels;
+        uint8_t* pixels = stbi_load(file.string().c_str(), &image.width, &image.height, &channels, 4);
+        if (!pixels) {
+            std::fprintf(stderr, "Failed to load '%s': %s\n", file.string().c_str(), stbi_failure_reason());
+            return false;
+        }
+        image.pixels.assign(pixels, pixels + static_cast<size_t>(image.width) * image.height * 4);
+        stbi_image_free(pixels);
+
+        image.sourceWidth = image.width;
+        image.sourceHeight = image.height;
+        if (options.trim) {
+            TrimImage(image);
+        }
+        images.push_back(std::move(image));
+    }
+    return true;
+}
+
+// Big images first packs much tighter; name breaks ties for determinism
+static bool PackImages(const std::vector<SourceImage>& images, const AtlasOptions& options,
+                       std::vector<AtlasPage>& pages) {
+    std::vector<const SourceImage*> order;
+    for (const auto& image : images) order.push_back(&image);
+    std::sort(order.begin(), order.end(), [](const SourceImage* a, const SourceImage* b) {
+        int aSide = std::max(a->width, a->height);
+        int bSide = std::max(b->width, b->height);
+        if (aSide != bSide) return aSide > bSide;
+        int aArea = a->width * a->height;
+        int bArea = b->width * b->height;
+        if (aArea != bArea) return aArea > bArea;
+        return a->name < b->name;
+    });
+
+    int border = options.extrude * 2 + options.padding;
+    for (const SourceImage* image : order) {
+        int w = image->width + border;
+        int h = image->height + border;
+        if (w > options.maxSize || h > options.maxSize) {
+            std::fprintf(stderr, "'%s' (%dx%d) does not fit in a %d page\n",
+                         image->name.c_str(), image->width, image->height, options.maxSize);
+            return false;
+        }
+
+        // First page with room, otherwise start a new one
+        MaxRectsPacker::Rect rect;
+        AtlasPage* target = nullptr;
+        for (auto& page : pages) {
+            if (page.packer.Insert(w, h, rect)) {
+                target = &page;
+                break;
+            }
+        }
+        if (!target) {
+            pages.emplace_back(options.maxSize);
+            target = &pages.back();
+            target->packer.Insert(w, h, rect);
+        }
+        target->placements.push_back({ image, rect.x + options.extrude, rect.y + options.extrude });
+    }
+    return true;
+}
+
+// Copy sprite pixels and repeat their outer rows/columns into the extrusion border,
+// so filtering and mips near the edge sample the sprite instead of its neighbours
+static void BlitPlacement(std::vector<uint8_t>& atlas, int atlasWidth, const Placement& placement,
+                          int extrude) {
+    const SourceImage& image = *placement.image;
+    for (int y = -extrude; y < image.height + extrude; ++y) {
+        int srcY = std::clamp(y, 0, image.height - 1);
+        for (int x = -extrude; x < image.width + extrude; ++x) {
+            int srcX = std::clamp(x, 0, image.width - 1);
+            const uint8_t* src = &image.pixels[(static_cast<size_t>(srcY) * image.width + srcX) * 4];
+            uint8_t* dst = &atlas[(static_cast<size_t>(placement.y + y) * atlasWidth + placement.x + x) * 4];
+            std::memcpy(dst, src, 4);
+        }
+    }
+}
+
+static void WriteJsonString(FILE* file, const std::string& text) {
+    std::fputc('"', file);
+    for (char c : text) {
+        if (c == '"' || c == '\\') std::fputc('\\', file);
+        std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+static bool WriteSheetJson(const std::string& jsonPath, const std::string& textureName,
+                           const AtlasPage& page, const AtlasOptions& options) {
+    FILE* file = std::fopen(jsonPath.c_str(), "wb");
+    if (!file) {
+        std::fprintf(stderr, "Failed to write '%s'\n", jsonPath.c_str());
+        return false;
+    }
+
+    std::vector<const Placement*> sorted;
+    for (const auto& placement : page.placements) sorted.push_back(&placement);
+    std::sort(sorted.begin(), sorted.end(), [](const Placement* a, const Placement* b) {
+        return a->image->name < b->image->name;
+    });
+
+    std::fprintf(file, "{\n    \"texture\": ");
+    WriteJsonString(file, textureName);
+    std::fprintf(file, ",\n");
+    if (!options.filter.empty()) {
+        std::fprintf(file, "    \"filter\": ");
+        WriteJsonString(file, options.filter);
+        std::fprintf(file, ",\n");
+    }
+    // Clean gap around a sprite's pixels: its own extrusion plus the padding.
+    // The neighbour's extrusion repeats the neighbour's colours, so it doesn't count
+    std::fprintf(file, "    \"padding\": %d,\n", options.padding + options.extrude);
+    std::fprintf(file, "    \"sprites\": {\n");
+
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const Placement& placement = *sorted[i];
+        const SourceImage& image = *placement.image;
+        std::fprintf(file, "        ");
+        WriteJsonString(file, image.name);
+        std::fprintf(file, ": { \"x\": %d, \"y\": %d, \"w\": %d, \"h\": %d",
+                     placement.x, placement.y, image.width, image.height);
+        if (image.width != image.sourceWidth || image.height != image.sourceHeight) {
+            // Where the trimmed pixels sat in the original image (Sprite::GetTrimmedQuad)
+            std::fprintf(file, ", \"trim\": { \"x\": %d, \"y\": %d, \"w\": %d, \"h\": %d }",
+                         image.trimX, image.trimY, image.sourceWidth, image.sourceHeight);
+        }
+        std::fprintf(file, " }%s\n", i + 1 < sorted.size() ? "," : "");
+    }
+
+    std::fprintf(file, "    }\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+static bool WritePage(const AtlasPage& page, const std::string& basePath, const AtlasOptions& options) {
+    int width = page.packer.GetUsedWidth();
+    int height = page.packer.GetUsedHeight();
+    if (options.powerOfTwo) {
+        width = NextPowerOfTwo(width);
+        height = NextPowerOfTwo(height);
+    }
+
+    std::vector<uint8_t> atlas(static_cast<size_t>(width) * height * 4, 0);
+    for (const auto& placement : page.placements) {
+        BlitPlacement(atlas, width, placement, options.extrude);
+    }
+
+    std::string pngPath = basePath + ".png";
+    if (!stbi_write_png(pngPath.c_str(), width, height, 4, atlas.data(), width * 4)) {
+        std::fprintf(stderr, "Failed to write '%s'\n", pngPath.c_str());
+        return false;
+    }
+
+    // Texture path is relative to the JSON, which sits next to the PNG
+    std::string textureName = fs::path(pngPath).filename().string();
+    if (!WriteSheetJson(basePath + ".json", textureName, page, options)) {
+        return false;
+    }
+
+    std::printf("%s.png/.json: %zu sprites, %dx%d\n", basePath.c_str(), page.placements.size(), width, height);
+    return true;
+}
+
+static bool ParseIntArg(int argc, char** argv, int& i, int minValue, int& out) {
+    if (i + 1 >= argc) return false;
+    out = std::atoi(argv[++i]);
+    return out >= minValue;
+}
+
+int main(int argc, char** argv) {
+    AtlasOptions options;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool ok = true;
+        if (std::strcmp(argv[i], "--size") == 0) {
+            ok = ParseIntArg(argc, argv, i, 1, options.maxSize);
+        } else if (std::strcmp(argv[i], "--padding") == 0) {
+            ok = ParseIntArg(argc, argv, i, 0, options.padding);
+        } else if (std::strcmp(argv[i], "--extrude") == 0) {
+            ok = ParseIntArg(argc, argv, i, 0, options.extrude);
+        } else if (std::strcmp(argv[i], "--trim") == 0) {
+            options.trim = true;
+        } else if (std::strcmp(argv[i], "--no-pot") == 0) {
+            options.powerOfTwo = false;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else {
+            positional.push_back(argv[i]);
+        }
+        if (!ok) {
+            std::fprintf(stderr, "Invalid value for %s\n", arg);
+            return 1;
+        }
+    }
+
+    if (positional.size() != 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<SourceImage> images;
+    if (!LoadImages(positional[0], options, images)) {
+        return 1;
+    }
+    if (images.empty()) {
+        std::fprintf(stderr, "No images found in '%s'\n", positional[0].c_str());
+        return 1;
+    }
+
+    std::vector<AtlasPage> pages;
+    if (!PackImages(images, options, pages)) {
+        return 1;
+    }
+
+    const std::string& prefix = positional[1];
+    for (size_t i = 0; i < pages.size(); ++i) {
+        std::string basePath = pages.size() == 1 ? prefix : prefix + "_" + std::to_string(i);
+        if (!WritePage(pages[i], basePath, options)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "engine/gfx/CookedTexture.h"
+#include <stb_image.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * boxer_texcook - converts images into the cooked .btex format.
+ *
+ * Usage:
+ *   boxer_texcook [--no-mips] <image> [<image> ...]
+ *   boxer_texcook [--no-mips] -o <out.btex> <image>
+ *
+ * Each input is written next to the source with a .btex extension
+ * unless -o is given. TextureCache picks the cooked file up automatically.
+ */
+
+static void PrintUsage() {
+    std::printf("Usage: boxer_texcook [--no-mips] [-o output.btex] <image> [<image> ...]\n");
+}
+
+static bool CookImage(const std::string& inputPath, const std::string& outputPath, bool generateMips) {
+    // Flip once here so the runtime can upload rows as-is
+    stbi_set_flip_vertically_on_load(true);
+
+    int width, height, channels;
+    uint8_t* pixels = stbi_load(inputPath.c_str(), &width, &height, &channels, 4);  // Force RGBA
+    if (!pixels) {
+        std::fprintf(stderr, "Failed to load '%s': %s\n", inputPath.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    bool ok = engine::CookedTexture::Write(outputPath, pixels, width, height, generateMips);
+    stbi_image_free(pixels);
+
+    if (!ok) {
+        std::fprintf(stderr, "Failed to write '%s'\n", outputPath.c_str());
+        return false;
+    }
+
+    std::printf("%s -> %s (%dx%d%s)\n", inputPath.c_str(), outputPath.c_str(),
+                width, height, generateMips ? ", mips" : "");
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool generateMips = true;
+    std::string outputPath;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--no-mips") == 0) {
+            generateMips = false;
+        } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+
+    if (inputs.empty() || (!outputPath.empty() && inputs.size() != 1)) {
+        PrintUsage();
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& input : inputs) {
+        std::string output = outputPath.empty() ? engine::CookedTexture::GetCookedPath(input) : outputPath;
+        if (!CookImage(input, output, generateMips)) {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}